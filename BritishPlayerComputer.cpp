@@ -1,14 +1,40 @@
 #include "BritishPlayerComputer.h"
-#include "GameDirector.h"
+#include "GameContext.h"
 #include "SearchBoard.h"
 #include "Utils.h"
+#include "GameState.h"
+#include "GameHash.h"
 #include <cassert>
+#include <cstring>
 using namespace std;
 
 // Constructor
-BritishPlayerComputer::BritishPlayerComputer() {
+BritishPlayerComputer::BritishPlayerComputer(GameContext& context):
+	context(context)
+{
 	coastalFreeSearchList = getCoastalFreeSearchZones();
-	initialAirPatrols = planInitialAirPatrols();
+	planInitialAirPatrols();
+}
+
+// Save our part of the game state
+void BritishPlayerComputer::saveState(GameState& gameState) const {
+	memcpy(&gameState.british, &state, sizeof state);
+}
+
+// Restore our part of the game state
+void BritishPlayerComputer::restoreState(const GameState& gameState) {
+	memcpy(&state, &gameState.british, sizeof state);
+}
+
+// Compute our part of the game hash
+//   (air patrol plan is fixed at start, so never updated)
+uint64_t BritishPlayerComputer::calcHash() const {
+	uint64_t hash = 0;
+	for (int day = 0; day < AIR_PATROL_DAYS; day++) {
+		hash ^= GameHash::key(GameHash::AIR_PATROLS, day, 
+			state.initialAirPatrols[day]);
+	}
+	return hash;
 }
 
 // Try searching
@@ -21,12 +47,12 @@ void BritishPlayerComputer::searchZones(
 	const std::vector<GridCoordinate>& zones,
 	int dayStrength, int nightStrength)
 {
-	auto game = GameDirector::instance();
+	auto& game = context.getDirector();
 	for (auto zone: zones) {
-		int strength = game->isInDay(zone) ? 
+		int strength = game.isInDay(zone) ? 
 			dayStrength : nightStrength;
-		if (game->isSearchable(zone, strength)) {
-			game->searchGermanShips(zone);			
+		if (game.isSearchable(zone, strength)) {
+			game.searchGermanShips(zone);			
 		}
 	}
 }
@@ -34,8 +60,10 @@ void BritishPlayerComputer::searchZones(
 // Basic search in first few turns
 void BritishPlayerComputer::resolveSearch() {
 	searchZones(coastalFreeSearchList, 4, 3);
-	searchZones(getShipPatrolZones(), 4, 2);
-	searchZones(getAirPatrolZones(), 6, 3);
+	fillShipPatrolZones(patrolList);
+	searchZones(patrolList, 4, 2);
+	fillAirPatrolZones(patrolList);
+	searchZones(patrolList, 6, 3);
 }
 
 // Compile the list of free coastal search spaces
@@ -45,10 +73,11 @@ vector<GridCoordinate> BritishPlayerComputer::getCoastalFreeSearchZones()
 	vector<GridCoordinate> list = {"D9", "F15", "G18"};
 			
 	// Add everything from map layer of British/Irish coast
+	auto& board = context.getBoard();
 	for (char row = 'A'; row < 'Z'; row++) {
 		for (int col = 1; col < 29; col++) {
 			GridCoordinate zone(row, col);
-			if (SearchBoard::instance()->isBritishCoast(zone)) {
+			if (board.isBritishCoast(zone)) {
 				list.push_back(zone);
 			}
 		}
@@ -56,38 +85,39 @@ vector<GridCoordinate> BritishPlayerComputer::getCoastalFreeSearchZones()
 	return list;
 }
 
-// Get list of ship patrol zones
-vector<GridCoordinate> BritishPlayerComputer::getShipPatrolZones()
+// Fill list of ship patrol zones
+void BritishPlayerComputer::fillShipPatrolZones(vector<GridCoordinate>& list)
 {
 	// Standard ship patrols
-	vector<GridCoordinate> list = {"B7", "D12", "E13", "F14", "G15", "H16"};
+	list = {"B7", "D12", "E13", "F14", "G15", "H16"};
 	
 	// Suffolk somewhere off Iceland
-	GridCoordinate suffolk('D', 3 + diceRoll(2, 3));
+	auto& random = context.getRandom(GameContext::BRITISH_AI);
+	int roll = random.diceRoll(2, 3);
+	GridCoordinate suffolk('D', 3 + roll);
 	list.push_back(suffolk);
-	return list;
 }
 
 // Distribute initial air patrol numbers
 //   An abstracted estimate of early air search strength
-vector<int> BritishPlayerComputer::planInitialAirPatrols() {
-	const int NUM_DAYS = 5;
+void BritishPlayerComputer::planInitialAirPatrols() {
 	const int TOTAL_AIR_PATROLS = 20;
-	vector<int> patrolsPerDay(NUM_DAYS);
+	auto& patrolsPerDay = state.initialAirPatrols;
+	fill(patrolsPerDay, patrolsPerDay + AIR_PATROL_DAYS, 0);
+	auto& random = context.getRandom(GameContext::BRITISH_AI);
 	for (int i = 0; i < TOTAL_AIR_PATROLS; i++) {
-		int day = diceRoll(2, 3) - 2;
+		int day = random.diceRoll(2, 3) - 2;
 		patrolsPerDay[day]++;
 	}
-	return patrolsPerDay;
 }
 
-// Get list of air patrol zones
-vector<GridCoordinate> BritishPlayerComputer::getAirPatrolZones()
+// Fill list of air patrol zones
+void BritishPlayerComputer::fillAirPatrolZones(vector<GridCoordinate>& list)
 {
-	vector<GridCoordinate> list;
-	int turnsElapsed = GameDirector::instance()->getTurnsElapsed();
-	if (turnsElapsed < (int) initialAirPatrols.size()) {
-		int numPatrolsToday = initialAirPatrols[turnsElapsed];
+	list.clear();
+	int turnsElapsed = context.getDirector().getTurnsElapsed();
+	if (turnsElapsed < AIR_PATROL_DAYS) {
+		int numPatrolsToday = state.initialAirPatrols[turnsElapsed];
 		for (int i = 0; i < numPatrolsToday; i++) {
 			GridCoordinate searchZone = pickAirPatrolZone();
 			while (hasElem(list, searchZone)) {
@@ -96,15 +126,15 @@ vector<GridCoordinate> BritishPlayerComputer::getAirPatrolZones()
 			list.push_back(searchZone);			
 		}
 	}
-	return list;
 }
 
 // Get a random zone for an air patrol
 //   Column pick suggested by MicroBismarck LRS results
 GridCoordinate BritishPlayerComputer::pickAirPatrolZone() {
 	int col;
-	char row = 'A' + rand(6);
-	switch (dieRoll(13)) {
+	auto& random = context.getRandom(GameContext::BRITISH_AI);
+	char row = 'A' + random.rand(6);
+	switch (random.dieRoll(13)) {
 		case 1: col = 18; break;
 		case 2: col = 17; break;
 		case 3: col = 16; break;
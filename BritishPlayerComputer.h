@@ -9,11 +9,12 @@
 #define BRITISHPLAYERCOMPUTER_H
 #include "BritishPlayerInterface.h"
 #include <vector>
+#include <cstdint>
 
 class BritishPlayerComputer: public BritishPlayerInterface
 {
 	public:
-		BritishPlayerComputer();
+		BritishPlayerComputer(GameContext& context);
 
 		// Start and end game confirmation
 		bool okStartGame() override { return true; }
@@ -45,16 +46,31 @@ class BritishPlayerComputer: public BritishPlayerInterface
 		// Response to enemy request
 		bool checkSearch(const GridCoordinate& zone) override
 			{ return false; }
-		
+
+		void saveState(GameState& gameState) const override;
+		void restoreState(const GameState& gameState) override;
+		uint64_t calcHash() const override;
+
+	private:
+		static const int AIR_PATROL_DAYS = 5;
+
+	public:
+		// Our part of the game state (see GameState)
+		struct State {
+			uint8_t initialAirPatrols[AIR_PATROL_DAYS];
+		};
+
 	private:
-		std::vector<int> initialAirPatrols;
+		GameContext& context;
+		State state;
 		std::vector<GridCoordinate> coastalFreeSearchList;
+		std::vector<GridCoordinate> patrolList; // refilled each turn
 		void searchZones(const std::vector<GridCoordinate>& zones,
 			int dayStrength, int nightStrength);
 		std::vector<GridCoordinate> getCoastalFreeSearchZones();
-		std::vector<GridCoordinate> getShipPatrolZones();
-		std::vector<GridCoordinate> getAirPatrolZones();		
-		std::vector<int> planInitialAirPatrols();
+		void fillShipPatrolZones(std::vector<GridCoordinate>& list);
+		void fillAirPatrolZones(std::vector<GridCoordinate>& list);
+		void planInitialAirPatrols();
 		GridCoordinate pickAirPatrolZone();
 };
 
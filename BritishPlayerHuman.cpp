@@ -1,8 +1,14 @@
 #include "BritishPlayerHuman.h"
-#include "GameDirector.h"
+#include "GameContext.h"
 #include "Utils.h"
 using namespace std;
 
+// Constructor
+BritishPlayerHuman::BritishPlayerHuman(GameContext& context):
+	context(context)
+{
+}
+
 // Ask if we want to start game
 bool BritishPlayerHuman::okStartGame() {
 	cout << "Start game (y/n)? ";
@@ -76,7 +82,7 @@ void BritishPlayerHuman::resolveSearch() {
 	const char END_SEARCH = '@';
 	cout << "Enter zones to search "
 		<< "(" <<  END_SEARCH << " to end):\n";
-	auto game = GameDirector::instance();
+	auto& game = context.getDirector();
 	while (true) {
 		cout << "==> ";
 		string input;
@@ -89,15 +95,15 @@ void BritishPlayerHuman::resolveSearch() {
 			continue;
 		}
 		GridCoordinate zone(input);
-		if (game->isVisibilityX()) {
+		if (game.isVisibilityX()) {
 			cout << "> Cannot search at visibility X.\n";
 			break;
 		}
-		if (game->isInFog(zone)) {
+		if (game.isInFog(zone)) {
 			cout << "> Cannot search in fog.\n";
 			continue;
 		}
-		game->searchGermanShips(zone);
+		game.searchGermanShips(zone);
 	}
 }
 
@@ -12,6 +12,7 @@
 class BritishPlayerHuman: public BritishPlayerInterface
 {
 	public:
+		BritishPlayerHuman(GameContext& context);
 
 		// Start and end game confirmation
 		bool okStartGame() override;
@@ -39,6 +40,9 @@ class BritishPlayerHuman: public BritishPlayerInterface
 		
 		// Response to enemy request
 		bool checkSearch(const GridCoordinate& zone);
+
+	private:
+		GameContext& context;
 };
 
 #endif
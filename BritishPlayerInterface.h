@@ -11,6 +11,10 @@
 #include "GridCoordinate.h"
 #include "NavalUnit.h"
 
+// Forwards
+class GameContext;
+struct GameState;
+
 // Abstract base class for British players
 class BritishPlayerInterface 
 {
@@ -44,6 +48,11 @@ class BritishPlayerInterface
 
 		// Response to enemy request
 		virtual bool checkSearch(const GridCoordinate& zone) = 0;
+
+		// Save & restore our part of game state (if any)
+		virtual void saveState(GameState&) const {}
+		virtual void restoreState(const GameState&) {}
+		virtual uint64_t calcHash() const { return 0; }
 };
 
 #endif
@@ -23,6 +23,9 @@ vector<vector<string>> CSVReader::readFile(const string &filename) {
 	} else {
 		string line;
 		while (getline(inFile, line)) {
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back(); // DOS line end read in Unix
+			}
 			vector<string> separatedLine = splitLine(line);
 			retVal.push_back(separatedLine);
 		}
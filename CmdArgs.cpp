@@ -1,29 +1,30 @@
 #include "CmdArgs.h"
 #include <iostream>
+#include <cstring>
+#include <ctime>
 using namespace std;
 
-// Pointer to the singleton object.
-CmdArgs* CmdArgs::theInstance = nullptr;
-
-// Accessor to the singleton object.
-CmdArgs* CmdArgs::instance() {
-	if (!theInstance) {
-		theInstance = new CmdArgs;
-	}
-	return theInstance;
-}
-
 // Constructor
+//   Random seed defaults to the clock
 CmdArgs::CmdArgs() {
+	seed = time(0);
 }
 
 // Print available options
 void CmdArgs::printOptions() const {
 	std::cout << "Command line options available:\n"
 		<< "\t-a automate British player\n"
+		<< "\t-c compare series against German variant number\n"
+		<< "\t-d directory of search board CSV files (else built-in)\n"
 		<< "\t-f finish on turn number\n"
+		<< "\t-g game number in series to replay\n"
+		<< "\t-j number of threads for series (0 = all cores)\n"
 		<< "\t-l large series of games\n"
-		<< "\t-n number of games to run\n"
+		<< "\t-n number of games to run (maximum if -p)\n"
+		<< "\t-p precision target: stop when 95% CIs this narrow\n"
+		<< "\t-s random seed\n"
+		<< "\t-t trace every German ship move in log\n"
+		<< "\t-v German strategy variant number\n"
 		<< "\n";
 	std::cout << "Optional (intermediate) rules:\n"
 		<< "\t-ofe fuel expenditure (rule 16.0)\n"
@@ -41,9 +42,17 @@ void CmdArgs::parseArgs(int argc, char** argv) {
 			switch (arg[1]) {
 				case 'l': runLargeSeries = true; // & fall through
 				case 'a': automateBritish = true; break;
+				case 'c': compareVariant = parseArgAsInt(arg); break;
+				case 'd': boardDir = parseArgAsString(arg); break;
 				case 'f': lastTurn = parseArgAsInt(arg); break;
+				case 'g': gameIndex = parseArgAsInt(arg); break;
+				case 'j': numThreads = parseArgAsInt(arg); break;
 				case 'n': numTrials = parseArgAsInt(arg); break;
 				case 'o': parseOptionalRule(arg); break;
+				case 'p': precision = parseArgAsFloat(arg); break;
+				case 's': seed = parseArgAsInt(arg); break;
+				case 't': traceMoves = true; break;
+				case 'v': strategyVariant = parseArgAsInt(arg); break;
 				default: setExitAfterArgs(); break;
 			}
 		}
@@ -70,6 +79,30 @@ int CmdArgs::parseArgAsInt(char *s) {
 	}
 }
 
+// Parse an argument as a floating-point number
+//   Format as -a=#.###
+double CmdArgs::parseArgAsFloat(char *s) {
+	if (strlen(s) > 3 && s[2] == '=') {
+		return atof(s + 3);
+	}
+	else {
+		setExitAfterArgs();
+		return -1.0;
+	}
+}
+
+// Parse an argument as a string
+//   Format as -a=text
+string CmdArgs::parseArgAsString(char *s) {
+	if (strlen(s) > 3 && s[2] == '=') {
+		return string(s + 3);
+	}
+	else {
+		setExitAfterArgs();
+		return "";
+	}
+}
+
 // Parse switch for optional (intermediate) rule
 void CmdArgs::parseOptionalRule(char *s) {
 	string arg(s);
@@ -4,15 +4,16 @@
 	Author: Daniel R. Collins
 	Date: 07-12-24 22:39
 	Description: Command-line argument handler.
-		Singleton class pattern.
+		Parsed once at startup, then shared read-only by all games.
 */
 #ifndef CMDARGS_H
 #define CMDARGS_H
+#include <string>
 
 class CmdArgs
 {
 	public:
-		static CmdArgs* instance();
+		CmdArgs();
 		void parseArgs(int argc, char** argv);
 		void printOptions() const;
 
@@ -22,6 +23,17 @@ class CmdArgs
 		bool isRunLargeSeries() const { return runLargeSeries; }
 		int getLastTurn() const { return lastTurn; }
 		int getNumTrials() const { return numTrials; }
+		int getNumThreads() const { return numThreads; }
+		unsigned getSeed() const { return seed; }
+		int getGameIndex() const { return gameIndex; }
+		int getStrategyVariant() const { return strategyVariant; }
+		int getCompareVariant() const { return compareVariant; }
+		bool isCompareSeries() const { return compareVariant >= 0; }
+		double getPrecision() const { return precision; }
+		const std::string& getBoardDir() const { return boardDir; }
+		bool isBoardFromFiles() const { return !boardDir.empty(); }
+		bool isTraceMoves() const { return traceMoves; }
+		void setStrategyVariant(int variant) { strategyVariant = variant; }
 
 		// Optional (intermediate) rules
 		bool useOptFuelExpenditure() const { return optFuelExpenditure; }
@@ -33,12 +45,19 @@ class CmdArgs
 	private:
 
 		// Data
-		static CmdArgs* theInstance;
 		bool exitAfterArgs = false;
 		bool automateBritish = false;
 		bool runLargeSeries = false;
 		int lastTurn = -1;
 		int numTrials = -1;
+		int numThreads = 1;
+		unsigned seed = 0;
+		int gameIndex = 0;
+		int strategyVariant = 0;
+		int compareVariant = -1;
+		double precision = 0.0;
+		std::string boardDir;
+		bool traceMoves = false;
 
 		// Optional rules
 		bool optFuelExpenditure = false;
@@ -48,8 +67,9 @@ class CmdArgs
 		bool optTirpitz = false;
 
 		// Functions
-		CmdArgs();
 		int parseArgAsInt(char *s);
+		double parseArgAsFloat(char *s);
+		std::string parseArgAsString(char *s);
 		void parseOptionalRule(char *s);
 		void setExitAfterArgs();
 };
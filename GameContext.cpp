@@ -0,0 +1,32 @@
+#include "GameContext.h"
+#include "CmdArgs.h"
+#include "GameState.h"
+#include <cstring>
+
+// Constructor
+//   Director builds the players, which may read board & rules,
+//   and roll dice for their setup
+GameContext::GameContext(const SearchBoard& board, const CmdArgs& args,
+		uint64_t gameIndex):
+	board(board), args(args), gameIndex(gameIndex),
+	random{{args.getSeed(), gameIndex, ENVIRONMENT},
+		{args.getSeed(), gameIndex, CHANCE},
+		{args.getSeed(), gameIndex, BRITISH_AI},
+		{args.getSeed(), gameIndex, GERMAN_AI}},
+	director(*this)
+{
+}
+
+// Save the state of our game (between turns)
+void GameContext::snapshot(GameState& state) const {
+	memcpy(state.random, random, sizeof random);
+	director.saveState(state);
+}
+
+// Restore our game to a saved state (between turns)
+//   The state must come from a game with the same rules
+//   (e.g., this one, or another of the same args)
+void GameContext::restore(const GameState& state) {
+	memcpy(random, state.random, sizeof random);
+	director.restoreState(state);
+}
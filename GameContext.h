@@ -0,0 +1,53 @@
+/*
+	Name: GameContext
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 16-10-26 16:05
+	Description: Everything one game needs to run.
+		Owns the director (with players & ships) for this game,
+		and its random numbers (keyed by seed & game index);
+		each use of randomness has its own stream, so two German
+		strategies can be played against the same weather & British.
+		It refers to a board and rules shared read-only by all games.
+		So many games can run at once in one process.
+		Between turns, the game may be saved & restored
+		as one block (see GameState).
+*/
+#ifndef GAMECONTEXT_H
+#define GAMECONTEXT_H
+#include "GameDirector.h"
+#include "RandomStream.h"
+
+// Forwards
+class SearchBoard;
+class CmdArgs;
+struct GameState;
+
+class GameContext
+{
+	public:
+		// Separate random streams by use
+		enum RandomUse {ENVIRONMENT, CHANCE, BRITISH_AI, GERMAN_AI,
+			NUM_RANDOM_USES};
+
+		GameContext(const SearchBoard& board, const CmdArgs& args,
+			uint64_t gameIndex = 0);
+		GameDirector& getDirector() { return director; }
+		const GameDirector& getDirector() const { return director; }
+		const SearchBoard& getBoard() const { return board; }
+		const CmdArgs& getArgs() const { return args; }
+		RandomStream& getRandom(RandomUse use) { return random[use]; }
+		uint64_t getGameIndex() const { return gameIndex; }
+		void snapshot(GameState& state) const;
+		void restore(const GameState& state);
+
+	private:
+		// Data (shared members must precede director)
+		const SearchBoard& board;
+		const CmdArgs& args;
+		uint64_t gameIndex;
+		RandomStream random[NUM_RANDOM_USES];
+		GameDirector director;
+};
+
+#endif
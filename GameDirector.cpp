@@ -1,47 +1,31 @@
 #include "GameDirector.h"
+#include "GameContext.h"
 #include "SearchBoard.h"
 #include "BritishPlayerInterface.h"
 #include "BritishPlayerComputer.h"
 #include "BritishPlayerHuman.h"
 #include "GermanPlayer.h"
 #include "GameStream.h"
+#include "GameState.h"
+#include "GameHash.h"
 #include "CmdArgs.h"
 #include "Utils.h"
 #include <chrono>
+#include <cstring>
 #include <cassert>
 using namespace std;
 
-// Singleton instance
-GameDirector* GameDirector::theInstance = nullptr;
-
-// Singleton instance accessor
-GameDirector* GameDirector::instance() {
-	if (!theInstance) {
-		theInstance = new GameDirector;
-	}
-	return theInstance;
-}
-
-// Set or reset singleton for a new game
-void GameDirector::initGame() {
-	if (theInstance) {
-		delete theInstance;	
-	}
-	theInstance = new GameDirector;
-}
-
 // Constructor
-GameDirector::GameDirector() {
-	logStartTime();
-	auto args = CmdArgs::instance();
-	germanPlayer = new GermanPlayer;
-	britishPlayer = args->isAutomatedBritish() ?
-		(BritishPlayerInterface*) new BritishPlayerComputer :
-		(BritishPlayerInterface*) new BritishPlayerHuman;
-	if (args->getLastTurn() > 0) {
-		finishTurn = args->getLastTurn();
+GameDirector::GameDirector(GameContext& context): context(context) {
+	auto& args = context.getArgs();
+	germanPlayer = new GermanPlayer(context);
+	britishPlayer = args.isAutomatedBritish() ?
+		(BritishPlayerInterface*) new BritishPlayerComputer(context) :
+		(BritishPlayerInterface*) new BritishPlayerHuman(context);
+	if (args.getLastTurn() > 0) {
+		state.finishTurn = args.getLastTurn();
 	}
-	dailyConvoySunk.push_back(false);
+	state.hash = calcHash();
 }
 
 // Destructor
@@ -52,6 +36,7 @@ GameDirector::~GameDirector() {
 
 // Ask player(s) to start the game
 bool GameDirector::okPlayerStart() {
+	logStartTime();
 	return britishPlayer->okStartGame();
 }
 		
@@ -65,11 +50,13 @@ void GameDirector::logStartTime() {
 	auto clock = std::chrono::system_clock::now();
 	auto timeNow = std::chrono::system_clock::to_time_t(clock);
 	cgame << "Game started " << std::ctime(&timeNow);
+	cgame << "Random seed " << context.getArgs().getSeed()
+		<< ", game " << context.getGameIndex() << endl;
 }
 
 // Is the game over? (Rule 12.1)
 bool GameDirector::isGameOver() const {
-	auto theBismarck = germanPlayer->getBismarck();
+	auto& theBismarck = germanPlayer->getBismarck();
 	if (germanPlayer->getStartNumShips() <= 2) { // Rule 52.1
 		if (!theBismarck.isAfloat()              // Rule 12.11
 			|| theBismarck.isEnteringPort())     // Rule 12.12
@@ -77,7 +64,7 @@ bool GameDirector::isGameOver() const {
 			return true;	
 		}
 	}
-	if (turn > finishTurn) {                     // Rule 12.14
+	if (state.turn > state.finishTurn) {         // Rule 12.14
 		return true; 
 	}              
 	return false;
@@ -86,23 +73,77 @@ bool GameDirector::isGameOver() const {
 // Do the game loop
 void GameDirector::doGameLoop() {
 	while (!isGameOver()) {
-		cgame << "\nTURN " << turn << endl;
-		checkNewDay();
-		doAvailabilityPhase();
-		doVisibilityPhase();
-		doShadowPhase();
-		doShipMovementPhase();
-		doSearchPhase();
-		doAirAttackPhase();
-		doNavalCombatPhase();
-		doChancePhase();
-		turn++;
+		doGameTurn();
 	}
 }
 
+// Do one game turn
+//   Between turns, the game may be saved (see GameState)
+void GameDirector::doGameTurn() {
+	cgame << "\nTURN " << state.turn << endl;
+	checkNewDay();
+	doAvailabilityPhase();
+	doVisibilityPhase();
+	doShadowPhase();
+	doShipMovementPhase();
+	doSearchPhase();
+	doAirAttackPhase();
+	doNavalCombatPhase();
+	doChancePhase();
+	updateHash(GameHash::change(GameHash::TURN, 0, 
+		state.turn, state.turn + 1));
+	state.turn++;
+	assert(state.hash == calcHash()); // debug check of incremental hash
+}
+
+// Get hash of the game state
+//   Kept up to date as the hashed features change (see calcHash)
+uint64_t GameDirector::getHash() const {
+	return state.hash;
+}
+
+// Compute hash of the game state from scratch
+uint64_t GameDirector::calcHash() const {
+	return GameHash::key(GameHash::TURN, 0, state.turn)
+		^ GameHash::key(GameHash::VISIBILITY, 0, state.visibility)
+		^ GameHash::key(GameHash::FOG, 0, state.foggy)
+		^ GameHash::key(GameHash::CONVOYS_SUNK, 0, state.convoysSunk)
+		^ hashConvoySunkDays(state.convoySunkDays)
+		^ germanPlayer->calcHash()
+		^ britishPlayer->calcHash();
+}
+
+// Get hash keys for the days convoys were sunk
+//   (bitmask keyed in two halves)
+uint64_t GameDirector::hashConvoySunkDays(uint64_t days) {
+	return GameHash::key(GameHash::CONVOY_SUNK_DAYS, 0, (int) days)
+		^ GameHash::key(GameHash::CONVOY_SUNK_DAYS, 1, (int) (days >> 32));
+}
+
+// Update hash for changed feature(s)
+void GameDirector::updateHash(uint64_t keys) {
+	state.hash ^= keys;
+}
+
+// Save our part of the game state, & the players'
+void GameDirector::saveState(GameState& gameState) const {
+	memcpy(&gameState.director, &state, sizeof state);
+	germanPlayer->saveState(gameState.german);
+	britishPlayer->saveState(gameState);
+}
+
+// Restore our part of the game state, & the players'
+//   (relinking task forces touches the hash; keep the saved one)
+void GameDirector::restoreState(const GameState& gameState) {
+	memcpy(&state, &gameState.director, sizeof state);
+	germanPlayer->restoreState(gameState.german);
+	britishPlayer->restoreState(gameState);
+	state.hash = gameState.director.hash;
+}
+
 // Get current turn
 int GameDirector::getTurn() const {
-	return turn;	
+	return state.turn;	
 }
 
 // Get turn number of the starting turn
@@ -127,20 +168,20 @@ bool GameDirector::isStartTurn() const {
 
 // Get current visibility
 int GameDirector::getVisibility() const {
-	assert(visibility <= VISIBILITY_X);
-	return visibility;	
+	assert(state.visibility <= VISIBILITY_X);
+	return state.visibility;	
 }
 
 // Is visibility at the maximum level?
 //   Prevents search, combat, convoys (Rule 7.17 + errara)
 bool GameDirector::isVisibilityX() const {
-	assert(visibility <= VISIBILITY_X);
-	return visibility == VISIBILITY_X;	
+	assert(state.visibility <= VISIBILITY_X);
+	return state.visibility == VISIBILITY_X;	
 }
 
 // Report on night time
 void GameDirector::reportNightTime() {
-	switch (turn % 6) {
+	switch (state.turn % 6) {
 		case 0: cgame << "Night in southern latitudes.\n"; break;
 		case 1: cgame << "Night at all latitudes.\n"; break;
 		default: break; // Day; print nothing
@@ -149,6 +190,11 @@ void GameDirector::reportNightTime() {
 
 // Is this zone currently in night time? (Rule 11.11)
 bool GameDirector::isInNight(const GridCoordinate& zone) const {
+	return isInNight(zone, state.turn);
+}
+
+// Is this zone in night time on a given turn? (Rule 11.11)
+bool GameDirector::isInNight(const GridCoordinate& zone, int turn) const {
 	switch (turn % 6) {
 		case 0: return zone.getRow() >= 'L';
 		case 1: return true;
@@ -163,7 +209,12 @@ bool GameDirector::isInDay(const GridCoordinate& zone) const {
 
 // Is this zone currently in fog?
 bool GameDirector::isInFog(const GridCoordinate& zone) const {
-	return foggy && SearchBoard::instance()->isFogZone(zone);
+	return state.foggy && context.getBoard().isFogZone(zone);
+}
+
+// Is there currently fog (in fog zones)?
+bool GameDirector::isFoggy() const {
+	return state.foggy;
 }
 
 // Is this zone currently searchable at the given search strength?
@@ -172,13 +223,15 @@ bool GameDirector::isSearchable(
 {
 	return !isVisibilityX()
 		&& !isInFog(zone)
-		&& strength >= visibility;
+		&& strength >= state.visibility;
 }
 
 // Handle start of a new calendar day
 void GameDirector::checkNewDay() {
-	if (turn % 6 == 1) { // new day
-		dailyConvoySunk.push_back(false);
+	if (state.turn % 6 == 1) { // new day
+		updateHash(hashConvoySunkDays(state.convoySunkDays)
+			^ hashConvoySunkDays(state.convoySunkDays << 1));
+		state.convoySunkDays <<= 1;
 	}
 }
 
@@ -193,8 +246,9 @@ void GameDirector::doVisibilityPhase() {
 		rollVisibility();
 	}
 	cgame << "Visibility: " 
-		<< (visibility == VISIBILITY_X ? "X" : to_string(visibility))
-		<< (foggy ? ", with fog" : "") << endl;
+		<< (state.visibility == VISIBILITY_X ? 
+			"X" : to_string(state.visibility))
+		<< (state.foggy ? ", with fog" : "") << endl;
 	reportNightTime();
 	germanPlayer->doVisibilityPhase();
 }
@@ -241,47 +295,60 @@ void GameDirector::doChancePhase() {
 // Roll for visibility
 //   See Basic Player Aid Card: Visibility Track and Change
 void GameDirector::rollVisibility() {
-	assert(isInInterval(1, visibility, VISIBILITY_X));
-	int roll = diceRoll(2, 6);
+	assert(isInInterval(1, state.visibility, VISIBILITY_X));
+	auto& random = context.getRandom(GameContext::ENVIRONMENT);
+	int roll = random.diceRoll(2, 6);
+	int oldVisibility = state.visibility;
+	bool oldFoggy = state.foggy;
 	
 	// Modify roll for current visibility
 	//   NOTE: Modifier signs flipped by errata in General 16/2
 	//   And more realistic per our real-data weather research
-	switch (visibility) {
+	switch (state.visibility) {
 		case 1: roll += 1; break;
 		case 7: roll -= 1; break;
 		case 8: case 9: roll -= 2; break;	
 	}
 	
 	// Determine new visibility
-	visibility += roll - 7;
-	visibility = max(1, visibility);
-	visibility = min(9, visibility);
-	assert(isInInterval(1, visibility, VISIBILITY_X));
+	state.visibility += roll - 7;
+	state.visibility = max(1, state.visibility);
+	state.visibility = min(9, state.visibility);
+	assert(isInInterval(1, state.visibility, VISIBILITY_X));
 	
 	// Determine fog
 	switch (roll) {
 		case 5: case 6: case 8: case 10: case 12: case 13: case 14:
-			foggy = true; break;
+			state.foggy = true; break;
 		default:
-			foggy = false; break;
+			state.foggy = false; break;
 	}
+	updateHash(GameHash::change(GameHash::VISIBILITY, 0,
+		oldVisibility, state.visibility)
+		^ GameHash::change(GameHash::FOG, 0, oldFoggy, state.foggy));
 }
 
 // Get notice that a convoy was sunk
 void GameDirector::msgSunkConvoy() {
-	dailyConvoySunk.back() = true;
+	if (!(state.convoySunkDays & 1)) {
+		updateHash(hashConvoySunkDays(state.convoySunkDays)
+			^ hashConvoySunkDays(state.convoySunkDays | 1)
+			^ GameHash::change(GameHash::CONVOYS_SUNK, 0, 
+			state.convoysSunk, state.convoysSunk + 1));
+		state.convoySunkDays |= 1;
+		state.convoysSunk++;
+	}
 }
 
 // Get number of convoys sunk
 int GameDirector::getConvoysSunk() const {
-	return count(dailyConvoySunk.begin(), dailyConvoySunk.end(), true);
+	return state.convoysSunk;
 }
 
 // Check if a convoy was sunk on a given day
 bool GameDirector::wasConvoySunk(unsigned daysAgo) const {
-	return daysAgo < dailyConvoySunk.size() ?
-		dailyConvoySunk.rbegin()[daysAgo] : false;
+	return daysAgo < MAX_CONVOY_DAYS ?
+		(state.convoySunkDays >> daysAgo) & 1 : false;
 }
 
 // Do end-game reporting
@@ -387,5 +454,10 @@ const Ship& GameDirector::getBismarck() const {
 // Is this a turn in which convoys move?
 //   That is: A "C-turn" on Time Record Track (Rule 5.24, etc.)
 bool GameDirector::isConvoyTurn() const {
+	return isConvoyTurn(state.turn);
+}
+
+// Is a given turn one in which convoys move?
+bool GameDirector::isConvoyTurn(int turn) const {
 	return !(turn % 2);
 }
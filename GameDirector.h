@@ -4,17 +4,19 @@
 	Author: Daniel R. Collins
 	Date: 27-11-24 00:04
 	Description: Director for Bismarck game mechanics.
-		Singleton class pattern.
+		One per game, owned by its GameContext.
 */
 #ifndef GAMEDIRECTOR_H
 #define GAMEDIRECTOR_H
 #include "GridCoordinate.h"
 #include "Ship.h"
-#include <vector>
+#include <cstdint>
 
 // Forward to player interfaces
 class BritishPlayerInterface;
 class GermanPlayer;
+class GameContext;
+struct GameState;
 
 // Class for game control
 class GameDirector
@@ -27,11 +29,13 @@ class GameDirector
 			SEARCH, AIR_ATTACK, NAVAL_COMBAT, CHANCE};
 		
 		// Functions
-		static GameDirector* instance();
-		static void initGame();
+		GameDirector(GameContext& context);
+		~GameDirector();
 		bool okPlayerStart();
 		void okPlayerEnd();
 		void doGameLoop();
+		void doGameTurn();
+		bool isGameOver() const;
 		void doEndGame();
 		int getTurn() const;
 		int getStartTurn() const;
@@ -41,9 +45,12 @@ class GameDirector
 		bool isVisibilityX() const;
 		bool isStartTurn() const;
 		bool isConvoyTurn() const;
+		bool isConvoyTurn(int turn) const;
 		bool isInDay(const GridCoordinate& zone) const;
 		bool isInNight(const GridCoordinate& zone) const;
+		bool isInNight(const GridCoordinate& zone, int turn) const;
 		bool isInFog(const GridCoordinate& zone) const;
+		bool isFoggy() const;
 		bool isSearchable(const GridCoordinate& zone, int strength) const;
 		bool searchGermanShips(const GridCoordinate& zone);
 		bool searchBritishShips(const GridCoordinate& zone);
@@ -56,30 +63,44 @@ class GameDirector
 		bool wasConvoySunk(unsigned daysAgo) const;
 		int getConvoysSunk() const;
 		const Ship& getBismarck() const;
+		uint64_t getHash() const;
+		uint64_t calcHash() const;
+		void updateHash(uint64_t keys);
+		void saveState(GameState& gameState) const;
+		void restoreState(const GameState& gameState);
 
 	private:
 		// Constants
 		static const int BASIC_START_TURN = 4;
 		static const int BASIC_FINISH_TURN = 34;
 		static const int VISIBILITY_X = 9;
+		static const unsigned MAX_CONVOY_DAYS = 64;
+
+	public:
+		// Our part of the game state (see GameState)
+		struct State {
+			int turn = BASIC_START_TURN;
+			int finishTurn = BASIC_FINISH_TURN;
+			int visibility = 4;
+			bool foggy = true;
+			int convoysSunk = 0;
+			uint64_t convoySunkDays = 0; // bit per day, today lowest
+			uint64_t hash = 0; // kept up to date (see GameHash)
+		};
+
+	private:
 
 		// Data
-		static GameDirector* theInstance;
+		GameContext& context;
 		GermanPlayer* germanPlayer = nullptr;
 		BritishPlayerInterface* britishPlayer = nullptr;
-		std::vector<bool> dailyConvoySunk;
-		int turn = BASIC_START_TURN;
-		int finishTurn = BASIC_FINISH_TURN;
-		int visibility = 4;
-		bool foggy = true;
+		State state;
 		
 		// Functions
-		GameDirector();
-		~GameDirector();
 		void logStartTime();
 		void checkNewDay();
 		void rollVisibility();
-		bool isGameOver() const;
+		static uint64_t hashConvoySunkDays(uint64_t days);
 		void reportNightTime();
 		
 		// Turn phase handlers (Rule 4.0)
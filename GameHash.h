@@ -0,0 +1,69 @@
+/*
+	Name: GameHash
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 17-10-26 16:30
+	Description: Zobrist-style keys for hashing the game state.
+		The hash is the XOR of one key per feature value
+		(e.g., a ship's zone), so a change updates it in place
+		with the old & new keys (see change()).
+		Keys are mixed from feature, object & value (SplitMix64
+		finalizer) instead of drawn into tables, so no range
+		of values (turns, damage) need be fixed in advance.
+		Covers the state the rules play on, not the German plan:
+		games alike but for orders or routes planned hash equal.
+*/
+#ifndef GAMEHASH_H
+#define GAMEHASH_H
+#include <cstdint>
+#include <string>
+
+class GameHash
+{
+	public:
+		// Features hashed
+		//   Ship log flags & move counts are keyed by the 
+		//   turn logged, & hashed only while set (nonzero)
+		enum Feature {TURN, VISIBILITY, FOG, CONVOYS_SUNK,
+			SHIP_ZONE, SHIP_FUEL_LOST, SHIP_MIDSHIPS_LOST,
+			SHIP_EVASION_LOST_TEMP, SHIP_EVASION_LOST_PERM,
+			CONVOY_SUNK_DAYS, AIR_PATROLS, 
+			SHIP_ON_PATROL, SHIP_RETURN_TO_BASE, SHIP_TASK_FORCE, 
+			SHIP_LOCATED, SHIP_SHADOWED, SHIP_COMBATED, 
+			SHIP_CONVOY_SUNK, SHIP_MOVES};
+
+		// Functions
+		static uint64_t key(Feature feature, uint32_t object, int value);
+		static uint64_t change(Feature feature, uint32_t object,
+			int oldValue, int newValue);
+		static uint32_t nameId(const std::string& name);
+};
+
+// Get the key for one feature value of an object
+//   (object zero for game-wide features)
+inline uint64_t GameHash::key(Feature feature, uint32_t object, int value) {
+	uint64_t x = ((uint64_t) object << 32 | (uint32_t) value)
+		^ ((uint64_t) feature * 0x9E3779B97F4A7C15);
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+	return x ^ (x >> 31);
+}
+
+// Get the keys to toggle for a change of value
+inline uint64_t GameHash::change(Feature feature, uint32_t object,
+	int oldValue, int newValue)
+{
+	return oldValue == newValue ? 0
+		: key(feature, object, oldValue) ^ key(feature, object, newValue);
+}
+
+// Get an object number from a name (FNV-1a)
+inline uint32_t GameHash::nameId(const std::string& name) {
+	uint32_t id = 2166136261u;
+	for (char c: name) {
+		id = (id ^ (uint8_t) c) * 16777619u;
+	}
+	return id;
+}
+
+#endif
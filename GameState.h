@@ -0,0 +1,35 @@
+/*
+	Name: GameState
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 17-10-26 16:10
+	Description: Everything that changes in one game, as one block:
+		director, German ships & task forces, British computer
+		player, and random streams. Trivially copyable, with
+		indices in place of pointers (board, rules & ship specs
+		are fixed by the context), so each part saves & restores
+		by memcpy. Used between turns (see GameContext::snapshot),
+		e.g., to replay or fork a game from a checkpoint.
+*/
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+#include "GameContext.h"
+#include "GameDirector.h"
+#include "GermanPlayer.h"
+#include "BritishPlayerComputer.h"
+#include "RandomStream.h"
+#include <type_traits>
+
+struct GameState {
+	GameDirector::State director;
+	GermanPlayer::State german;
+	BritishPlayerComputer::State british;
+	RandomStream random[GameContext::NUM_RANDOM_USES];
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value,
+	"GameState must be trivially copyable");
+static_assert(sizeof(GameState) <= 4096,
+	"GameState must fit in 4 KB");
+
+#endif
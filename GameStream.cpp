@@ -27,9 +27,12 @@ int GameStream::overflow(int c) {
 // Turn on game messages
 void GameStream::turnOn() {
 	active = true;	
+	clear();
 }
 		
 // Turn off game messages		
+//   Fail state skips all formatting (and is safe to share among threads)
 void GameStream::turnOff() {
 	active = false;	
+	setstate(std::ios::failbit);
 }
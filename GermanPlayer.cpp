@@ -1,39 +1,51 @@
 #include "GermanPlayer.h"
-#include "GameDirector.h"
+#include "GameContext.h"
 #include "SearchBoard.h"
+#include "RandomStream.h"
 #include "GameStream.h"
 #include "CmdArgs.h"
 #include "Utils.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 using namespace std;
 
 // Constructor
-GermanPlayer::GermanPlayer() {
+GermanPlayer::GermanPlayer(GameContext& context):
+	context(context), random(context.getRandom(GameContext::GERMAN_AI))
+{
 
 	// Construct basic ships
-	shipList.push_back(
-		Ship("Bismarck", Ship::Type::BB, 29, 10, 13, "F20", this));
-	shipList.push_back(			
-		Ship("Prinz Eugen", Ship::Type::CA, 32, 4, 10, "F20", this));
+	//   (reserved up front, so ship pointers stay valid;
+	//   per-turn lists too, so turns don't allocate)
+	shipList.reserve(MAX_SHIPS);
+	navalUnitList.reserve(MAX_SHIPS);
+	unitScan.zone.reserve(MAX_SHIPS);
+	shipsToJoin.reserve(MAX_SHIPS);
+	shipList.emplace_back(context,
+		"Bismarck", Ship::Type::BB, 29, 10, 13, "F20", this);
+	shipList.emplace_back(context,
+		"Prinz Eugen", Ship::Type::CA, 32, 4, 10, "F20", this);
 	
 	// Construct optional ships on command
-	auto cmd = CmdArgs::instance();
-	if (cmd->useOptScheer()) {
-		shipList.push_back(
-			Ship("Scheer", Ship::Type::PB, 26, 4, 13, "F20", this));
+	auto& cmd = context.getArgs();
+	if (cmd.useOptScheer()) {
+		shipList.emplace_back(context,
+			"Scheer", Ship::Type::PB, 26, 4, 13, "F20", this);
 	}
-	if (cmd->useOptTirpitz()) {
-		shipList.push_back(
-			Ship("Tirpitz", Ship::Type::BB, 29, 10, 13, "F20", this));
+	if (cmd.useOptTirpitz()) {
+		shipList.emplace_back(context,
+			"Tirpitz", Ship::Type::BB, 29, 10, 13, "F20", this);
 	}
-	if (cmd->useOptScharnhorsts()) {
-		shipList.push_back(
-			Ship("Scharnhorst", Ship::Type::BC, 32, 7, 13, "P23", this));
-		shipList.push_back(
-			Ship("Gneisenau", Ship::Type::BC, 32, 7, 13, "P23", this));
+	if (cmd.useOptScharnhorsts()) {
+		shipList.emplace_back(context,
+			"Scharnhorst", Ship::Type::BC, 32, 7, 13, "P23", this);
+		shipList.emplace_back(context,
+			"Gneisenau", Ship::Type::BC, 32, 7, 13, "P23", this);
 	}
 	
 	// Record key data
+	assert((int) shipList.size() <= MAX_SHIPS);
 	startNumShips = shipList.size();
 	theBismarck = &shipList.front();
 }
@@ -44,6 +56,48 @@ GermanPlayer::~GermanPlayer() {
 	taskForceList.clear();
 }
 
+// Compute our part of the game hash from scratch
+uint64_t GermanPlayer::calcHash() const {
+	uint64_t hash = 0;
+	for (auto& ship: shipList) {
+		hash ^= ship.calcHash();
+	}
+	return hash;
+}
+
+// Save our part of the game state
+void GermanPlayer::saveState(State& state) const {
+	state.numShips = shipList.size();
+	for (unsigned i = 0; i < shipList.size(); i++) {
+		memcpy(&state.ships[i], &shipList[i].getState(), 
+			sizeof(Ship::State));
+	}
+	assert((int) taskForceList.size() <= MAX_TASK_FORCES);
+	state.numTaskForces = 0;
+	for (auto& taffy: taskForceList) {
+		taffy.saveState(state.taskForces[state.numTaskForces++], 
+			shipList.data());
+	}
+}
+
+// Restore our part of the game state
+//   Task forces are rebuilt & their ships relinked
+void GermanPlayer::restoreState(const State& state) {
+	assert(state.numShips == (int) shipList.size());
+	for (unsigned i = 0; i < shipList.size(); i++) {
+		shipList[i].leaveTaskForce();
+		shipList[i].restoreState(state.ships[i]);
+	}
+	spareTaskForces.splice(spareTaskForces.end(), taskForceList);
+	for (int i = 0; i < state.numTaskForces; i++) {
+		auto& saved = state.taskForces[i];
+		addTaskForce(saved.identifier).restoreState(saved, shipList.data());
+	}
+	navalUnitList.clear();
+	foundShipZones.clear();
+	scanUnits();
+}
+
 // Get the Bismarck for special basic rules
 const Ship& GermanPlayer::getBismarck() const {
 	assert(theBismarck != nullptr);
@@ -91,6 +145,23 @@ void GermanPlayer::orderUnitsForTurn() {
 			navalUnitList.push_back(&ship);
 		}
 	}
+	scanUnits();
+}
+
+// Record where our units are (see UnitScan)
+void GermanPlayer::scanUnits() {
+	unitScan.zone.clear();
+	unitScan.zonesTouched = SearchBoardLayer();
+	for (auto& unit: navalUnitList) {
+		auto position = unit.getPosition();
+		unitScan.zone.push_back(position.isOnBoard() ? 
+			position.index() : -1);
+		unitScan.zonesTouched.setBitOn(position);
+		auto flagship = unit.getFlagship();
+		for (int i = 0; i < flagship->getSpeedThisTurn(); i++) {
+			unitScan.zonesTouched.setBitOn(flagship->getMoveThisTurn(i));
+		}
+	}
 }
 
 // Combine ships into task forces
@@ -112,7 +183,7 @@ void GermanPlayer::formTaskForces() {
 			}
 
 			// Gather up ships in zone
-			vector<Ship*> shipsToJoin;
+			shipsToJoin.clear();
 			auto zone = seedShip.getPosition();
 			for (auto& ship: shipList) {
 				if (ship.getPosition() == zone
@@ -126,11 +197,11 @@ void GermanPlayer::formTaskForces() {
 			
 			// Create a new task force
 			if (shipsToJoin.size() > 1) {
-				int newId = getNextTaskForceId();
-				taskForceList.push_back(TaskForce(newId));
+				auto& taffy = addTaskForce(getNextTaskForceId());
+				clog << taffy.getName() << " forming\n";
 				for (auto& ship: shipsToJoin) {
 					ship->clearOrders();			
-					taskForceList.back().attach(ship);
+					taffy.attach(ship);
 				}
 			}
 		}
@@ -164,16 +235,32 @@ void GermanPlayer::cleanTaskForces() {
 	}
 
 	// Delete any empty task forces
+	//   (list nodes are kept for reuse)
 	auto it = taskForceList.begin();
 	while (it != taskForceList.end()) {
 		if (it->isEmpty()) {
-			it = taskForceList.erase(it);	
+			spareTaskForces.splice(spareTaskForces.end(), 
+				taskForceList, it++);
 			continue;
 		}
 		it++;
 	}
 }
 
+// Add a new task force to our list
+//   Reuses a spare list node if any, so forming doesn't allocate
+TaskForce& GermanPlayer::addTaskForce(int id) {
+	if (spareTaskForces.empty()) {
+		taskForceList.emplace_back(id);
+	}
+	else {
+		taskForceList.splice(taskForceList.end(), 
+			spareTaskForces, spareTaskForces.begin());
+		taskForceList.back() = TaskForce(id);
+	}
+	return taskForceList.back();
+}
+
 // Clean task force as needed
 //   Sweep out sunk, slow, low-fuel ships
 void GermanPlayer::cleanTaskForce(TaskForce& taffy) {
@@ -211,9 +298,9 @@ TaskForce* GermanPlayer::getTaskForceById(int id) {
 // Do shadow phase
 void GermanPlayer::doShadowPhase() {
 	for (auto& unit: navalUnitList) {
-		if (unit->wasLocated(1)) {
-			GameDirector::instance()
-				->checkShadow(*unit, unit->getPosition(), 
+		if (unit.wasLocated(1)) {
+			context.getDirector()
+				.checkShadow(unit.get(), unit.getPosition(), 
 					GameDirector::Phase::SHADOW);
 		}
 	}
@@ -224,11 +311,13 @@ void GermanPlayer::doShipMovementPhase() {
 
 	// Move task forces & solo ships
 	for (auto& unit: navalUnitList) {
-		if (!unit->wasShadowed(0)) {
-			unit->doMovementTurn();	
+		if (!unit.wasShadowed(0)) {
+			unit.doMovementTurn();	
 		}
 	}
 	
+	scanUnits();
+
 	// Log all ship statuses
 	for (auto& ship: shipList) {
 		if (ship.isAfloat()) {
@@ -245,16 +334,16 @@ void GermanPlayer::doShipMovementPhase() {
 //   (Prior bug: Lose-turn field kept after TF dissolved)
 void GermanPlayer::testStoppedUnits() {
 	for (auto& unit: navalUnitList) {
-		if (unit->isAfloat()
-			&& !unit->getSpeedThisTurn()
-			&& !unit->isInPort()
-			&& !unit->isOnPatrol()
-			&& !unit->isReturnToBase()
-			&& !unit->wasConvoySunk(1)
-			&& !(unit->getFlagship()->hasOrders()
-				&& unit->getFlagship()->getFirstOrder() == Ship::STOP))
+		if (unit.isAfloat()
+			&& !unit.getSpeedThisTurn()
+			&& !unit.isInPort()
+			&& !unit.isOnPatrol()
+			&& !unit.isReturnToBase()
+			&& !unit.wasConvoySunk(1)
+			&& !(unit.getFlagship()->hasOrders()
+				&& unit.getFlagship()->getFirstOrder() == Ship::STOP))
 		{
-			cerr << "Error: Stopped unit: " << unit->getFullDesc() << "\n";
+			cerr << "Error: Stopped unit: " << unit.getFullDesc() << "\n";
 		}
 	}
 }
@@ -273,23 +362,28 @@ void GermanPlayer::testMoveAfterConvoySunk() {
 }
 
 // Check for search by British player
+//   Units not in or moving through zone are skipped at once
 bool GermanPlayer::checkSearch(const GridCoordinate& zone) {
+	if (!unitScan.zonesTouched.isBitOn(zone)) {
+		return false;
+	}
 	bool anyFound = false;
-	auto game = GameDirector::instance();
-	for (auto& unit: navalUnitList) {
- 		if (unit->getPosition() == zone) 
+	auto& game = context.getDirector();
+	for (unsigned i = 0; i < navalUnitList.size(); i++) {
+		auto& unit = navalUnitList[i];
+ 		if (unitScan.zone[i] == zone.index()) 
 		{
-			cgame << unit->getTypeDesc() 
-				<< " found in " << zone << endl;
-			unit->setLocated();
+			unit.printTypeDesc(cgame);
+			cgame << " found in " << zone << endl;
+			unit.setLocated();
 			anyFound = true;
 		}
-		else if (unit->movedThrough(zone)
-			&& !game->isStartTurn())
+		else if (unit.movedThrough(zone)
+			&& !game.isStartTurn())
 		{
-			cgame << unit->getTypeDesc()
-				<< " seen moving through " << zone << endl;
-			game->checkShadow(*unit, zone, 
+			unit.printTypeDesc(cgame);
+			cgame << " seen moving through " << zone << endl;
+			game.checkShadow(unit.get(), zone, 
 				GameDirector::Phase::SEARCH);
 			anyFound = true;
 		}
@@ -299,12 +393,12 @@ bool GermanPlayer::checkSearch(const GridCoordinate& zone) {
 
 // Do air attack phase
 void GermanPlayer::doAirAttackPhase() {
-	auto game = GameDirector::instance();
+	auto& game = context.getDirector();
 	for (auto& unit: navalUnitList) {
-		if (unit->wasLocated(0)     // Rule 9.11
-			&& !unit->isInPort())   // Rule 9.13
+		if (unit.wasLocated(0)     // Rule 9.11
+			&& !unit.isInPort())   // Rule 9.13
 		{
-			game->checkAttackOn(*unit, 
+			game.checkAttackOn(unit.get(), 
 				GameDirector::Phase::AIR_ATTACK);
 		}
 	}
@@ -312,30 +406,31 @@ void GermanPlayer::doAirAttackPhase() {
 
 // Do naval combat phase
 void GermanPlayer::doNavalCombatPhase() {
-	auto game = GameDirector::instance();
+	auto& game = context.getDirector();
 
 	// Check for attacks by British on our units
 	for (auto& unit: navalUnitList) {
-		if (unit->wasLocated(0)     // Rule 9.23
-			&& !unit->isInPort())   // Rule 12.7
+		if (unit.wasLocated(0)     // Rule 9.23
+			&& !unit.isInPort())   // Rule 12.7
 		{		
-			game->checkAttackOn(*unit, 
+			game.checkAttackOn(unit.get(), 
 				GameDirector::Phase::NAVAL_COMBAT);
 		}
 	}
 	
 	// Check for attacks we can make on British ships
 	for (auto& zone: foundShipZones) {
-		for (auto& unit: navalUnitList) {
-			if (unit->getPosition() == zone
-				&& unit->isAfloat()
-				&& !unit->wasCombated(0))
+		for (unsigned i = 0; i < navalUnitList.size(); i++) {
+			auto& unit = navalUnitList[i];
+			if (unitScan.zone[i] == zone.index()
+				&& unit.isAfloat()
+				&& !unit.wasCombated(0))
 			{
 				// Only attack with battleships
-				if (unit->getFlagship()->getGeneralType() 
+				if (unit.getFlagship()->getGeneralType() 
 					== Ship::BATTLESHIP)
 				{
-					game->checkAttackBy(*unit);
+					game.checkAttackBy(unit.get());
 				}
 			}
 		}
@@ -346,10 +441,12 @@ void GermanPlayer::doNavalCombatPhase() {
 //   See Basic Game Tables Card: Chance Table
 //   While RAW says British player makes this roll (Rule 10.1),
 //   it makes more sense for us with knowledge of ships on board.
+//   Rolls come from the chance stream, not our own decisions.
 void GermanPlayer::doChancePhase() {
+	auto& chance = context.getRandom(GameContext::CHANCE);
 	for (auto& unit: navalUnitList) {
-		if (unit->isOnBoard()) {
-			int roll = diceRoll(2, 6);
+		if (unit.isOnBoard()) {
+			int roll = chance.diceRoll(2, 6);
 			
 			// Huff-duff result
 			if (roll == 2) {
@@ -363,9 +460,9 @@ void GermanPlayer::doChancePhase() {
 			
 			// Convoy results
 			else if (roll <= 12) {
-				auto game = GameDirector::instance();
-				if (!game->wasConvoySunk(0)      // Rule 10.26
-					&& !game->isVisibilityX())   // Errata in General 16/2
+				auto& game = context.getDirector();
+				if (!game.wasConvoySunk(0)      // Rule 10.26
+					&& !game.isVisibilityX())   // Errata in General 16/2
 				{			
 					checkConvoyResult(unit, roll);
 				}
@@ -380,11 +477,11 @@ void GermanPlayer::doChancePhase() {
 }
 
 // Call result of British HUFF-DUFF detection
-void GermanPlayer::callHuffDuff(NavalUnit* unit) {
-	unit->setDetected();
+void GermanPlayer::callHuffDuff(const NavalUnitRef& unit) {
+	unit.setDetected();
+	auto& chance = context.getRandom(GameContext::CHANCE);
 	cgame << "HUFF-DUFF: German ship near "
-		<< SearchBoard::instance()
-			->randSeaZone(unit->getPosition(), 1)
+		<< context.getBoard().randSeaZone(unit.getPosition(), 1, chance)
 		<< endl;
 }
 
@@ -404,75 +501,59 @@ const int GS_VALUES[GS_ROWS][GS_COLS] = {
 
 // Check a general search result
 //   See Basic Game Tables Card: Chance Table
-void GermanPlayer::checkGeneralSearch(NavalUnit* unit, int roll) {
+void GermanPlayer::checkGeneralSearch(const NavalUnitRef& unit, 
+	int roll)
+{
 	assert(3 <= roll && roll <= 9);
-	auto pos = unit->getPosition();
-	auto board = SearchBoard::instance();
+	auto pos = unit.getPosition();
+	auto& board = context.getBoard();
 	
 	// Check if general search possible
-	if (board->isInsidePatrolLine(pos)     // Rule 10.211
-		&& !unit->isInFog()                // Rule 10.213
-		&& !unit->isInNight())             // Rule 11.13
+	if (board.isInsidePatrolLine(pos)     // Rule 10.211
+		&& !unit.isInFog()                // Rule 10.213
+		&& !unit.isInNight())             // Rule 11.13
 	{
 		// Look up search strength
-		char colLetter = getGeneralSearchColumn(pos);
+		char colLetter = board.getGeneralSearchColumn(pos);
 		int gsRowIdx = roll - 3;
 		int gsColIdx = colLetter - 'A';
 		int searchStrength = GS_VALUES[gsRowIdx][gsColIdx];
 		
 		// Announce result
-		int visibility = GameDirector::instance()->getVisibility();
+		int visibility = context.getDirector().getVisibility();
 		if (visibility <= searchStrength) {
-			unit->setDetected();
-			cgame << "General Search found " 
-				 << unit->getNameDesc() << " in " << pos << "\n";
+			unit.setDetected();
+			cgame << "General Search found ";
+			unit.printNameDesc(cgame);
+			cgame << " in " << pos << "\n";
 		}
 	}
 }
 
-// Get the applicable general search table row
-//   As per rule 10.214.
-char GermanPlayer::getGeneralSearchColumn(const GridCoordinate& zone) {
-	auto board = SearchBoard::instance();
-	
-	// Case 'A': western edge, near patrol line limit
-	if (board->isNearZoneType(zone, 2, board->isBritishPatrolLine)) {
-		return 'A';	
-	}
-
-	// Case 'C': eastern edge, near coast of Britain/Ireland
-	else if (board->isNearZoneType(zone, 2, board->isBritishCoast)) {
-		return 'C';		
-	}
-
-	// Case 'B': in-between, any other location
-	else {
-		return 'B';	
-	}
-}
-
 // Resolve a convoy result from the Chance Table
-void GermanPlayer::checkConvoyResult(NavalUnit* unit, int roll) {
+void GermanPlayer::checkConvoyResult(const NavalUnitRef& unit, 
+	int roll)
+{
 	assert(10 <= roll && roll <= 12);
-	auto board = SearchBoard::instance();
-	auto pos = unit->getPosition();
-	if (!unit->wasLocated(0)     // Rule 10.231
-		&& !unit->isInNight())   // Rule 11.13
+	auto& board = context.getBoard();
+	auto pos = unit.getPosition();
+	if (!unit.wasLocated(0)     // Rule 10.231
+		&& !unit.isInNight())   // Rule 11.13
 	{
 		switch (roll) {
 	
 			// On convoy route
 			case 10:
-				if (board->isConvoyRoute(pos)) {
+				if (board.isConvoyRoute(pos)) {
 					destroyConvoy(unit);				
 				}
 				break;
 	
 			// On patrol and within two
 			case 11:
-				if (unit->isOnPatrol()
-					&& board->isNearZoneType(pos, 2, 
-						&SearchBoard::isConvoyRoute))
+				if (unit.isOnPatrol()
+					&& board.isNearZoneType(pos, 2, 
+						SearchBoard::ConvoyRoutes))
 				{
 					destroyConvoy(unit);				
 				}
@@ -480,8 +561,8 @@ void GermanPlayer::checkConvoyResult(NavalUnit* unit, int roll) {
 				
 			// One zone from convoy route
 			case 12:
-				if (board->isNearZoneType(pos, 1, 
-					&SearchBoard::isConvoyRoute))
+				if (board.isNearZoneType(pos, 1, 
+					SearchBoard::ConvoyRoutes))
 				{
 					destroyConvoy(unit);
 				}
@@ -492,12 +573,13 @@ void GermanPlayer::checkConvoyResult(NavalUnit* unit, int roll) {
 
 // Score destruction of a convoy
 //   And re-route to new destination
-void GermanPlayer::destroyConvoy(NavalUnit* unit) {
+void GermanPlayer::destroyConvoy(const NavalUnitRef& unit) {
 	cgame << "CONVOY SUNK:"
-		<< " In zone " << unit->getPosition()
-		<< " by " << unit->getNameDesc() << endl;
-	GameDirector::instance()->msgSunkConvoy();
-	unit->setConvoySunk();
+		<< " In zone " << unit.getPosition() << " by ";
+	unit.printNameDesc(cgame);
+	cgame << endl;
+	context.getDirector().msgSunkConvoy();
+	unit.setConvoySunk();
 }
 
 // Print all of our ships (e.g., for end game)
@@ -525,19 +607,19 @@ void GermanPlayer::resolveSearch() {
 
 		// Add up search strength
 		int strength = 0;
-		for (auto& unit: navalUnitList) {
-			if (unit->getPosition() == zone
-				&& unit->wasLocated(0)) 
+		for (unsigned i = 0; i < navalUnitList.size(); i++) {
+			if (unitScan.zone[i] == zone.index()
+				&& navalUnitList[i].wasLocated(0)) 
 			{
-				strength += unit->getSearchStrength();
+				strength += navalUnitList[i].getSearchStrength();
 			}
 		}
 			
 		// Do the search
-		auto game = GameDirector::instance();
-		if (game->isSearchable(zone, strength)) {
-			if (game->searchBritishShips(zone)) {
-				foundShipZones.insert(zone);
+		auto& game = context.getDirector();
+		if (game.isSearchable(zone, strength)) {
+			if (game.searchBritishShips(zone)) {
+				addZone(foundShipZones, zone);
 				cgame << "German player locates ship(s) in " 
 					<< zone << "\n";
 			}
@@ -546,9 +628,36 @@ void GermanPlayer::resolveSearch() {
 }
 
 // Convert a map zone to a strategic region
-//   Splits map in 6 sections, mostly radiating from zone G15
+//   Looked up in table for zones on board
 GermanPlayer::MapRegion GermanPlayer::getRegion(
 	const GridCoordinate& zone) const
+{
+	return zone.isOnBoard() ? 
+		getRegionTable().zoneRegion[zone.index()] : calcRegion(zone);
+}
+
+// Get the table of regions (built on first use)
+const GermanPlayer::RegionTable& GermanPlayer::getRegionTable() {
+	static const RegionTable table;
+	return table;
+}
+
+// Build the table of regions
+GermanPlayer::RegionTable::RegionTable() {
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		zoneRegion[i] = calcRegion(GridCoordinate::fromIndex(i));
+	}
+	for (int region = 0; region < OFF_MAP; region++) {
+		regionZones[region] = SearchBoardLayer("Region",
+			[region](const GridCoordinate& zone) 
+				{ return calcRegion(zone) == region; });
+	}
+}
+
+// Calculate the strategic region of a map zone
+//   Splits map in 6 sections, mostly radiating from zone G15
+GermanPlayer::MapRegion GermanPlayer::calcRegion(
+	const GridCoordinate& zone)
 {
 	// Get zone components
 	char row = zone.getRow();
@@ -587,11 +696,13 @@ GermanPlayer::MapRegion GermanPlayer::getRegion(
 // Get orders for a ship before its move
 void GermanPlayer::getOrders(Ship& ship) {
 	bool needsNewGoal = false;
-	int lastTurn = GameDirector::instance()->getFinishTurn();
+	int lastTurn = context.getDirector().getFinishTurn();
 
-	// Abort if off-board
+	// Abort if off-board (stop order stays first)
 	if (ship.getPosition() == GridCoordinate::OFFBOARD) {
-		ship.orderAction(Ship::STOP);
+		if (!ship.hasOrders()) {
+			ship.orderAction(Ship::STOP);
+		}
 		return;
 	}
 	
@@ -640,17 +751,19 @@ void GermanPlayer::getOrders(Ship& ship) {
 void GermanPlayer::orderNewGoal(Ship& ship) {
 
 	// Gather data
-	GameDirector* game = GameDirector::instance();
-	SearchBoard* board = SearchBoard::instance();
+	auto& game = context.getDirector();
+	auto& board = context.getBoard();
 	GridCoordinate position = ship.getPosition();
 	MapRegion region = getRegion(position);
-	int visibility = game->getVisibility();
+	int visibility = game.getVisibility();
 	if (ship.isInNight()) {
 		visibility += 2; // approximation
 	}
+	int transitRisk = getTransitRisk();
+	bool timedTransit = transitRisk > 0; // cross patrol line by night
 
 	// At game start, choose breakout bonus move
-	if (game->isStartTurn()) {
+	if (game.isStartTurn()) {
 
 		// Start at Bergen
 		if (position == GridCoordinate("F20")) {
@@ -659,11 +772,12 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 			// while rows E-F in reach are mostly 2 zones from Britain
 			// (so, worst chance column for us: 10/36 found start turn)
 			// We take a small risk of that to widen search area
-			char row = dieRoll(100) <= 85 ? 'A' + rand(4): 'E' + rand(2);
-			int col = dieRoll(100) <= 50 ? 15 : 16 + rand(3);
+			char row = random.dieRoll(100) <= 85 ? 
+				'A' + random.rand(4): 'E' + random.rand(2);
+			int col = random.dieRoll(100) <= 50 ? 15 : 16 + random.rand(3);
 			if (row == 'F' && col == 15) { // Avoid Faeroe
 				ship.orderMove("G16");
-				ship.orderMove(board->randSeaZone("H15", 1));
+				ship.orderMove(board.randSeaZone("H15", 1, random));
 			} 
 			else {
 				ship.orderMove(GridCoordinate(row, col));
@@ -681,19 +795,19 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 			// However, British player can picket the entire
 			// max breakout line on start turn and beyond.
 			// So we use more of that area.
-			if (dieRoll(100) <= 50) { // Fast-track
-				char row = 'N' + rand(8);
+			if (random.dieRoll(100) <= 50) { // Fast-track
+				char row = 'N' + random.rand(8);
 				int col = (row <= 'P') ? 18 : row - 'P' + 18;
 				ship.orderMove(GridCoordinate(row, col));
 				if (row < 'P') {
-					ship.orderMove(board->randSeaZone("N15", 1));
+					ship.orderMove(board.randSeaZone("N15", 1, random));
 				}
-				ship.orderMove(randAfricanConvoyTarget());
+				ship.orderMove(randAfricanConvoyTarget(), transitRisk);
 				ship.orderAction(Ship::PATROL);
 			}
 			else { // Slow-roll near France
-				char row = 'P' + rand(5);
-				int col = row - 'P' + 18 + dieRoll(4);
+				char row = 'P' + random.rand(5);
+				int col = row - 'P' + 18 + random.dieRoll(4);
 				ship.orderMove(GridCoordinate(row, col));
 			}
 		}
@@ -712,7 +826,7 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 
 	// If in North Sea, move to Norway coast
 	else if (region == NORTH_SEA) {
-		ship.orderMove(board->randSeaZone("D17", 1));
+		ship.orderMove(board.randSeaZone("D17", 1, random));
 	}
 
 	// Move away from Norway
@@ -720,25 +834,25 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 
 		// If on highest-risk zone, breakout ASAP
 		if (position == GridCoordinate("G16")) {
-			ship.orderMove(randConvoyTarget(50));
+			ship.orderMove(randConvoyTarget(50), transitRisk);
 			ship.orderAction(Ship::PATROL);
 		}
 
 		// If located, move out ASAP
 		else if (ship.wasLocated(1)) {
-			ship.orderMove(board->randSeaZone("B13", 1));
+			ship.orderMove(board.randSeaZone("B13", 1, random));
 		}
 
 		// Break out in bad weather or late game
 		else if (visibility > 6
-			|| dieRoll(6) < game->getTurn() - 6)
+			|| random.dieRoll(6) < game.getTurn() - 6)
 		{
 			ship.orderMove(GridCoordinate(position.getRow(), 14));
 		}
 
 		// Loiter near Norway
 		else {
-			ship.orderMove(randLoiterZone(ship));
+			ship.orderMove(randLoiterZone(ship), transitRisk);
 			ship.orderAction(Ship::STOP); // if current zone
 		}
 	}
@@ -749,22 +863,22 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 		// Maybe break south if conditions right
 		if (visibility > 4
 			&& position.getRow() >= 'C'
-			&& dieRoll(6) <= 3)
+			&& random.dieRoll(6) <= 3)
 		{
-			ship.orderMove(board->randSeaZone("F13", 1));
+			ship.orderMove(board.randSeaZone("F13", 1, random));
 		}
 		
 		// Otherwise go for Denmark Strait
 		else {
-			ship.orderMove(dieRoll(2) == 1 ? "A10" : "B11");
+			ship.orderMove(random.dieRoll(2) == 1 ? "A10" : "B11");
 		}
 	}
 	
 	// Move through Denmark Strait
 	else if (region == DENMARK_STRAIT) {
 		ship.orderMove("B7");
-		int colOnRowC = 5 + rand(3);
-		int colOnRowE = colOnRowC + rand(3);
+		int colOnRowC = 5 + random.rand(3);
+		int colOnRowE = colOnRowC + random.rand(3);
 		ship.orderMove(GridCoordinate('C', colOnRowC));
 		ship.orderMove(GridCoordinate('E', colOnRowE));
 	}
@@ -775,39 +889,44 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 		
 		// Coming out of Denmark Strait to Africa,
 		// be sure to transit outside patrol line asap
+		// (strategy variant 1: skip Africa, stay on Atlantic line)
 		if (position.getCol() < 10
 			&& (position.getRow() < 'E' 
-				|| board->isInsidePatrolLine(position)))
+				|| board.isInsidePatrolLine(position)))
 		{
-			auto target = randConvoyTarget(66);
+			int variant = context.getArgs().getStrategyVariant();
+			auto target = randConvoyTarget(variant == 1 ? 100 : 66);
 			if (getRegion(target) == EAST_ATLANTIC) {
-				ship.orderMove(randDenmarkStraitToAfricaTransit(ship));
+				ship.orderMove(randDenmarkStraitToAfricaTransit(ship),
+					transitRisk, timedTransit);
 			}
-			ship.orderMove(target);
+			ship.orderMove(target, transitRisk);
 			ship.orderAction(Ship::PATROL);
 		}
 
 		// If inside patrol line, want to get out/prefer closer line
-		else if (board->isInsidePatrolLine(position)) {
-			ship.orderMove(randConvoyTargetWeightNearby(ship));
+		else if (board.isInsidePatrolLine(position)) {
+			ship.orderMove(randConvoyTargetWeightNearby(ship), 
+				transitRisk, timedTransit);
 			ship.orderAction(Ship::PATROL);
 		}
 
 		// Expect we just had combat or convoy sunk.
 		// Very small chance we want to stay in area
-		else if (dieRoll(6) <= 1) {
-			ship.orderMove(randConvoyTarget(isInWest ? 100: 0));
+		else if (random.dieRoll(6) <= 1) {
+			ship.orderMove(randConvoyTarget(isInWest ? 100: 0), transitRisk);
 			ship.orderAction(Ship::PATROL);
 		}
 		
 		// Otherwise, 50/50 if we should go to other line or Azores
 		else {
-			if (dieRoll(6) <= 3) {
-				ship.orderMove(randConvoyTarget(isInWest ? 0 : 100));
+			if (random.dieRoll(6) <= 3) {
+				ship.orderMove(randConvoyTarget(isInWest ? 0 : 100), 
+					transitRisk);
 				ship.orderAction(Ship::PATROL);
 			}
 			else {
-				ship.orderMove(randAzoresZone());
+				ship.orderMove(randAzoresZone(), transitRisk);
 			}
 		}
 	}
@@ -815,7 +934,7 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 	// Use Azores to hide out, e.g., after convoy sinking
 	// (We rarely get this far, and never time to get out)
 	else if (region == AZORES) {
-		int lastTurn = game->getFinishTurn();
+		int lastTurn = game.getFinishTurn();
 
 		// Exit via row Z late-game (Rule 51.6)
 		if (ship.convoyETA() > lastTurn
@@ -827,25 +946,25 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 
 		// Move somewhere if we're found or combated
 		else if (ship.wasLocated(1) || ship.wasCombated(1)) {
-			if (dieRoll(6) <= 2) {
-				ship.orderMove(randAzoresZone());
+			if (random.dieRoll(6) <= 2) {
+				ship.orderMove(randAzoresZone(), transitRisk);
 				ship.orderAction(Ship::STOP); // if current zone
 			}
 			else {
-				ship.orderMove(randConvoyTarget(50));
+				ship.orderMove(randConvoyTarget(50), transitRisk);
 				ship.orderAction(Ship::PATROL);
 			}
 		}
 
 		// Small chance to return convoy hunting on our own
-		else if (dieRoll(6) <= 1) {
-			ship.orderMove(randConvoyTarget(50));
+		else if (random.dieRoll(6) <= 1) {
+			ship.orderMove(randConvoyTarget(50), transitRisk);
 			ship.orderAction(Ship::PATROL);
 		}
 		
 		// Otherwise loiter in current region
 		else {
-			ship.orderMove(randLoiterZone(ship));
+			ship.orderMove(randLoiterZone(ship), transitRisk);
 			ship.orderAction(Ship::STOP); // if current zone
 		}
 	}
@@ -855,7 +974,7 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 	else if (region == BAY_OF_BISCAY) {
 
 		// Get out ASAP (don't loiter inside patrol line)
-		ship.orderMove(randAfricanConvoyTarget());
+		ship.orderMove(randAfricanConvoyTarget(), transitRisk);
 		ship.orderAction(Ship::PATROL);
 	}
 	
@@ -867,17 +986,22 @@ void GermanPlayer::orderNewGoal(Ship& ship) {
 }
 
 // Get an adjacent zone for a ship loitering in a region
+//   Pick directly from zones in reach that are in the same region
+//   (same odds as rerolling a move in area until region matches)
 GridCoordinate GermanPlayer::randLoiterZone(const Ship& ship) const {
-	GridCoordinate move = GridCoordinate::OFFBOARD;
-	while (getRegion(move) != getRegion(ship.getPosition())) {
-		move = ship.randMoveInArea(1);
-	};
-	return move;
+	auto& board = context.getBoard();
+	auto position = ship.getPosition();
+	MapRegion region = getRegion(position);
+	assert(region != OFF_MAP);
+	auto& regionZones = getRegionTable().regionZones[region];
+	auto moves = (board.getReach(position, 1) & regionZones)
+		- board.getLayer(SearchBoard::GermanPorts);
+	return moves.randZoneOn(random);
 }
 
 // Pick a convoy target from between the two lines
 GridCoordinate GermanPlayer::randConvoyTarget(int pctAtlantic) const {
-	return dieRoll(100) <= pctAtlantic ?
+	return random.dieRoll(100) <= pctAtlantic ?
 		randAtlanticConvoyTarget() : randAfricanConvoyTarget();
 }
 
@@ -885,13 +1009,13 @@ GridCoordinate GermanPlayer::randConvoyTarget(int pctAtlantic) const {
 //   Weight distance as chance to find convoy on patrol (2:3:5:3:2)
 //   Around row H, on western edge past patrol line
 GridCoordinate GermanPlayer::randAtlanticConvoyTarget() const {
-	auto board = SearchBoard::instance();
+	auto& board = context.getBoard();
 	GridCoordinate zone = GridCoordinate::OFFBOARD;
-	while (!board->isSeaZone(zone)
-		|| board->isInsidePatrolLine(zone))
+	while (!board.isSeaZone(zone)
+		|| board.isInsidePatrolLine(zone))
 	{
 		char row = 'H' + randWeightedConvoyDistance();
-		int col = dieRoll(7);
+		int col = random.dieRoll(7);
 		zone = GridCoordinate(row, col);		
 	}
 	return zone;
@@ -901,12 +1025,12 @@ GridCoordinate GermanPlayer::randAtlanticConvoyTarget() const {
 //   Weight distance as chance to find convoy on patrol (2:3:5:3:2)
 //   Row P to Y, near convoy beyond patrol line
 GridCoordinate GermanPlayer::randAfricanConvoyTarget() const {
-	auto board = SearchBoard::instance();
+	auto& board = context.getBoard();
 	GridCoordinate zone = GridCoordinate::OFFBOARD;
-	while (!board->isSeaZone(zone)
-		|| board->isInsidePatrolLine(zone))
+	while (!board.isSeaZone(zone)
+		|| board.isInsidePatrolLine(zone))
 	{
-		int inc = rand(10);
+		int inc = random.rand(10);
 		char row = 'P' + inc;
 		int col = 15 + (inc + 1) / 2 + randWeightedConvoyDistance();
 		zone = GridCoordinate(row, col);		
@@ -918,7 +1042,7 @@ GridCoordinate GermanPlayer::randAfricanConvoyTarget() const {
 //   Weighted by chance to find convoy on patrol (2:3:5:3:2)
 //   As per Chance Table convoy results (out of 36 options)
 int GermanPlayer::randWeightedConvoyDistance() const {
-	switch (dieRoll(15)) {
+	switch (random.dieRoll(15)) {
 		case 1: case 2: return -2;
 		case 3: case 4: case 5: return -1;
 		default: return 0;
@@ -930,7 +1054,7 @@ int GermanPlayer::randWeightedConvoyDistance() const {
 // Use optional rule for return-to-base when fuel empty (Rule 16.3)
 void GermanPlayer::handleFuelEmpty(Ship& ship) {
 	assert(!ship.getFuel());
-	if (CmdArgs::instance()->useOptFuelExpenditure()) {
+	if (context.getArgs().useOptFuelExpenditure()) {
 
 		// First fuel-empty notice
 		if (!ship.isReturnToBase()) {
@@ -951,18 +1075,18 @@ void GermanPlayer::handleFuelEmpty(Ship& ship) {
 	}
 }
 
+// Get risk scale for routes crossing open sea
+//   Steers around patrol line & British coast (see Navigator)
+//   (strategy variant 2: take shortest routes only)
+int GermanPlayer::getTransitRisk() const {
+	return context.getArgs().getStrategyVariant() == 2 ? 0 : TRANSIT_RISK;
+}
+
 // Find the nearest friendly port for a given ship
+//   By sea, precomputed on the board
 GridCoordinate GermanPlayer::findNearestPort(const Ship& ship) const {
-	int minDistance = INT_MAX;
-	auto nearestPort = GridCoordinate::OFFBOARD;
-	auto portList = SearchBoard::instance()->getAllGermanPorts();
-	for (auto& port: portList) {
-		int distance = port.distanceFrom(ship.getPosition());
-		if (distance < minDistance) {
-			nearestPort = port;
-			minDistance = distance;
-		}
-	}
+	auto nearestPort = context.getBoard().getNearest(
+		ship.getPosition(), SearchBoard::ToGermanPorts);
 	assert(nearestPort != GridCoordinate::OFFBOARD);
 	return nearestPort;	
 }
@@ -979,26 +1103,26 @@ GridCoordinate GermanPlayer::randDenmarkStraitToAfricaTransit(
 	while (!ship.isAccessible(targetZone)) {
 
 		// Vary northwest along patrol up to 3 spaces
-		int inc = rand(4);
+		int inc = random.rand(4);
 		char row = bestZone.getRow() - inc;
 		int col = bestZone.getCol() - inc;
 
 		// Vary southwest past patrol line up to 5 spaces
 		// (This includes where Bismarck shook Sheffield)
-		row += rand(6);
+		row += random.rand(6);
 		targetZone = GridCoordinate(row, col);
 	}
-	assert(!SearchBoard::instance()->isInsidePatrolLine(targetZone));
+	assert(!context.getBoard().isInsidePatrolLine(targetZone));
 	return targetZone;
 }
 
 // Get a random point in the Azores region to hide
 GridCoordinate GermanPlayer::randAzoresZone() const {
 	auto target = GridCoordinate::OFFBOARD;
-	auto board = SearchBoard::instance();
-	while (!board->isSeaZone(target)) {
-		char row = 'L' + rand(13);
-		int col = 3 + row - 'L' - rand(8);
+	auto& board = context.getBoard();
+	while (!board.isSeaZone(target)) {
+		char row = 'L' + random.rand(13);
+		int col = 3 + row - 'L' - random.rand(8);
 		target = GridCoordinate(row, col);
 	}
 	assert(getRegion(target) == AZORES);	
@@ -1013,25 +1137,33 @@ GridCoordinate GermanPlayer::randConvoyTargetWeightNearby(
 	auto position = ship.getPosition();
 	int distAtlantic = position.distanceFrom("H5");
 	int distAfrican = position.distanceFrom("P15");
-	int roll = dieRoll(distAtlantic + distAfrican);
+	int roll = random.dieRoll(distAtlantic + distAfrican);
 	return roll <= distAtlantic ? // small chance to avoid closer line
 		randAfricanConvoyTarget() : randAtlanticConvoyTarget();
 }
 
 // Get the set of zones where we have ships
-set<GridCoordinate> GermanPlayer::getShipZones() const {
-	set<GridCoordinate> shipZones;
+GermanPlayer::ZoneList GermanPlayer::getShipZones() const {
+	ZoneList shipZones;
 	for (auto& ship: shipList) {
 		auto zone = ship.getPosition();
 		if (ship.isAfloat()
 			&& zone != GridCoordinate::OFFBOARD)
 		{
-			shipZones.insert(zone);
+			addZone(shipZones, zone);
 		}
 	}
 	return shipZones;	
 }
 
+// Add a zone to a sorted zone list (if not already there)
+void GermanPlayer::addZone(ZoneList& zones, const GridCoordinate& zone) {
+	auto pos = lower_bound(zones.begin(), zones.end(), zone);
+	if (pos == zones.end() || *pos != zone) {
+		zones.insert(pos, zone);
+	}
+}
+
 // Get a minimal-distance zone on row Z
 GridCoordinate GermanPlayer::randCloseRowZ(const Ship& ship) const {
 	auto pos = ship.getPosition();
@@ -1039,5 +1171,5 @@ GridCoordinate GermanPlayer::randCloseRowZ(const Ship& ship) const {
 	int maxCol = min(pos.getCol() + 'Z' - pos.getRow(), 26);
 	int width = maxCol - minCol + 1;
 	assert(width >= 1);
-	return GridCoordinate('Z', minCol + rand(width));
+	return GridCoordinate('Z', minCol + random.rand(width));
 }
@@ -9,14 +9,20 @@
 #define GERMANPLAYER_H
 #include "Ship.h"
 #include "TaskForce.h"
+#include "NavalUnitRef.h"
+#include "SearchBoardLayer.h"
+#include "InlineVector.h"
 #include <vector>
 #include <list>
-#include <set>
+
+// Forwards
+class GameContext;
+class RandomStream;
 
 class GermanPlayer
 {
 	public:
-		GermanPlayer();
+		GermanPlayer(GameContext& context);
 		~GermanPlayer();
 		void doAvailabilityPhase();
 		void doVisibilityPhase();
@@ -32,39 +38,90 @@ class GermanPlayer
 		void getOrders(Ship& ship);
 		int getStartNumShips() const;
 		const Ship& getBismarck() const;
+		uint64_t calcHash() const;
+
+		// Constants
+		static const int MAX_SHIPS = TaskForce::MAX_SHIPS;
+		static const int MAX_TASK_FORCES = MAX_SHIPS / 2;
+
+		// Our part of the game state (see GameState)
+		//   Saved between turns (units are listed anew each turn)
+		struct State {
+			int numShips;
+			Ship::State ships[MAX_SHIPS];
+			int numTaskForces;
+			TaskForce::State taskForces[MAX_TASK_FORCES];
+		};
+		void saveState(State& state) const;
+		void restoreState(const State& state);
 
 	private:
+		// Constants
+		static const int TRANSIT_RISK = 1;
+
 		// Enumeration
 		enum MapRegion {NORTH_SEA, EAST_NORWEGIAN, WEST_NORWEGIAN, 
 			DENMARK_STRAIT, WEST_ATLANTIC, EAST_ATLANTIC, 
 			AZORES, BAY_OF_BISCAY, OFF_MAP};
 
+		// Region of each zone, & zones in each region
+		//   Computed once, shared by all players
+		struct RegionTable {
+			MapRegion zoneRegion[GridCoordinate::NUM_ZONES];
+			SearchBoardLayer regionZones[OFF_MAP];
+			RegionTable();
+		};
+
+		// List of zones (sorted, no repeats)
+		//   At most one per ship, so held inline
+		typedef InlineVector<GridCoordinate, MAX_SHIPS> ZoneList;
+
+		// Hot data for phase loops over our units
+		//   Zone of each unit (in unit list order), & every zone
+		//   a unit is in or moved through this turn (so searches
+		//   of other zones skip the units); rebuilt when units 
+		//   are listed & after they move
+		struct UnitScan {
+			std::vector<int> zone; // index, or -1 if off board
+			SearchBoardLayer zonesTouched;
+		};
+
 		// Data
+		GameContext& context;
+		RandomStream& random;
 		int startNumShips;
 		Ship* theBismarck;
-		std::list<Ship> shipList;
+		std::vector<Ship> shipList; // contiguous; never reallocated
 		std::list<TaskForce> taskForceList;
-		std::list<NavalUnit*> navalUnitList;
-		std::set<GridCoordinate> foundShipZones;
+		std::list<TaskForce> spareTaskForces; // nodes kept for reuse
+		std::vector<NavalUnitRef> navalUnitList;
+		UnitScan unitScan;
+		std::vector<Ship*> shipsToJoin; // reused forming task forces
+		ZoneList foundShipZones;
 		
 		// Functions
-		void checkGeneralSearch(NavalUnit* unit, int roll);
-		void checkConvoyResult(NavalUnit* unit, int roll);
-		void callHuffDuff(NavalUnit* unit);
-		void destroyConvoy(NavalUnit* unit);
-		char getGeneralSearchColumn(const GridCoordinate& zone);
+		void checkGeneralSearch(const NavalUnitRef& unit, int roll);
+		void checkConvoyResult(const NavalUnitRef& unit, int roll);
+		void callHuffDuff(const NavalUnitRef& unit);
+		void destroyConvoy(const NavalUnitRef& unit);
 
 		// Plotting functions
 		void orderUnitsForTurn();
+		void scanUnits();
 		void formTaskForces();
 		void cleanTaskForces();
 		void cleanTaskForce(TaskForce& taffy);
+		TaskForce& addTaskForce(int id);
 		void orderNewGoal(Ship& ship);
 		void handleFuelEmpty(Ship& ship);
 		int getNextTaskForceId();
 		TaskForce* getTaskForceById(int id);
 		MapRegion getRegion(const GridCoordinate& zone) const;
-		std::set<GridCoordinate> getShipZones() const;
+		static MapRegion calcRegion(const GridCoordinate& zone);
+		static const RegionTable& getRegionTable();
+		ZoneList getShipZones() const;
+		static void addZone(ZoneList& zones, const GridCoordinate& zone);
+		int getTransitRisk() const;
 
 		// Plot-targeting functions
 		GridCoordinate randLoiterZone(const Ship& ship) const;
@@ -1,10 +1,31 @@
 #include "GridCoordinate.h"
 #include "Utils.h"
 #include <cassert>
+#include <cstring>
+#include <cstdint>
 
 // Off-board marker
 const GridCoordinate GridCoordinate::OFFBOARD('~', 0);
 
+// Distances between all zones on board
+//   Built once at startup; read-only after that
+static uint8_t distanceTable
+	[GridCoordinate::NUM_ZONES][GridCoordinate::NUM_ZONES];
+
+// Initializer for the distance table
+struct DistanceTableBuilder {
+	DistanceTableBuilder() {
+		for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+			auto src = GridCoordinate::fromIndex(i);
+			for (int j = 0; j < GridCoordinate::NUM_ZONES; j++) {
+				auto dest = GridCoordinate::fromIndex(j);
+				distanceTable[i][j] = src.calcDistance(dest);
+			}
+		}
+	}
+};
+static DistanceTableBuilder distanceTableBuilder;
+
 // Default constructor
 GridCoordinate::GridCoordinate() {
 	*this = OFFBOARD;
@@ -45,8 +66,24 @@ std::string GridCoordinate::toString() const {
 	return *this == OFFBOARD ? "OFFBOARD" : row + std::to_string(col);
 }
 
+// Get zone from dense index
+GridCoordinate GridCoordinate::fromIndex(int index) {
+	assert(0 <= index && index < NUM_ZONES);
+	return GridCoordinate(MIN_ROW + index / NUM_COLS, 
+		MIN_COL + index % NUM_COLS);
+}
+
 // Distance from another zone
+//   Looked up in table if both on board
 int GridCoordinate::distanceFrom(const GridCoordinate& dest) const {
+	if (isOnBoard() && dest.isOnBoard()) {
+		return distanceTable[index()][dest.index()];
+	}
+	return calcDistance(dest);
+}
+
+// Calculate distance from another zone
+int GridCoordinate::calcDistance(const GridCoordinate& dest) const {
 	int spanLeft, spanRight;
 	int rowDiff = abs(row - dest.row);
 
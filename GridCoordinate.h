@@ -5,6 +5,8 @@
 	Date: 23-11-24 23:11
 	Description: Grid-coordinates for zones on search board.
 		Rows & columns as shown on printed game board.
+		Zones on the board also have a dense index (row-major),
+		for tables & flat arrays keyed by zone.
 */
 #ifndef GRIDCOORDINATE_H
 #define GRIDCOORDINATE_H
@@ -24,18 +26,43 @@ class GridCoordinate
 		std::string toString() const;
  		int distanceFrom(const GridCoordinate& dest) const;
 		std::vector<GridCoordinate> getArea(int radius) const;
+		bool isOnBoard() const;
+		int index() const;
+		static GridCoordinate fromIndex(int index);
 		bool operator==(const GridCoordinate& other) const;
 		bool operator!=(const GridCoordinate& other) const;
 		bool operator<(const GridCoordinate& other) const;
 		static bool isValid(const char *s);
 		static bool isValid(const std::string s);
 		static const GridCoordinate OFFBOARD;
+
+		// Board dimensions
+		static const char MIN_ROW = 'A';
+		static const char MAX_ROW = 'Z';
+		static const int MIN_COL = 1;
+		static const int MAX_COL = 29;
+		static const int NUM_ROWS = MAX_ROW - MIN_ROW + 1;
+		static const int NUM_COLS = MAX_COL - MIN_COL + 1;
+		static const int NUM_ZONES = NUM_ROWS * NUM_COLS;
 		
 	private:
 		typedef char int8;
 		int8 row, col;
+		int calcDistance(const GridCoordinate& dest) const;
+		friend struct DistanceTableBuilder;
 };
 
+// Is this zone on the board?
+inline bool GridCoordinate::isOnBoard() const {
+	return MIN_ROW <= row && row <= MAX_ROW
+		&& MIN_COL <= col && col <= MAX_COL;
+}
+
+// Get dense index of zone on board (0 to NUM_ZONES - 1)
+inline int GridCoordinate::index() const {
+	return (row - MIN_ROW) * NUM_COLS + (col - MIN_COL);
+}
+
 // Hashing structure
 struct GridCoordinateHash {
 	std::size_t operator()(const GridCoordinate& coord) const;
@@ -0,0 +1,104 @@
+/*
+	Name: InlineVector
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 17-10-26 10:05
+	Description: Vector of fixed capacity, stored inline (no heap).
+		For the small lists a ship keeps (orders, route, moves),
+		so that copying, clearing & refilling never allocate.
+		Elements are default-constructed in place; exceeding
+		the capacity is an error.
+*/
+#ifndef INLINEVECTOR_H
+#define INLINEVECTOR_H
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+template <class T, int N>
+class InlineVector
+{
+	public:
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		typedef std::reverse_iterator<T*> reverse_iterator;
+		typedef std::reverse_iterator<const T*> const_reverse_iterator;
+
+		// Accessors
+		static int capacity() { return N; }
+		std::size_t size() const { return count; }
+		bool empty() const { return !count; }
+		bool full() const { return count == N; }
+		T& operator[](int idx) { return items[idx]; }
+		const T& operator[](int idx) const { return items[idx]; }
+		T& front() { assert(count); return items[0]; }
+		const T& front() const { assert(count); return items[0]; }
+		T& back() { assert(count); return items[count - 1]; }
+		const T& back() const { assert(count); return items[count - 1]; }
+
+		// Iterators
+		T* begin() { return items; }
+		T* end() { return items + count; }
+		const T* begin() const { return items; }
+		const T* end() const { return items + count; }
+		reverse_iterator rbegin() { return reverse_iterator(end()); }
+		reverse_iterator rend() { return reverse_iterator(begin()); }
+		const_reverse_iterator rbegin() const
+			{ return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const
+			{ return const_reverse_iterator(begin()); }
+
+		// Mutators
+		void clear() { count = 0; }
+		void push_back(const T& item);
+		void pop_back() { assert(count); count--; }
+		void pop_front();
+		T* insert(T* pos, const T& item);
+		T* erase(T* pos);
+
+	private:
+		T items[N];
+		int count = 0;
+};
+
+// Add an item at the back
+template <class T, int N>
+inline void InlineVector<T, N>::push_back(const T& item) {
+	assert(count < N);
+	items[count++] = item;
+}
+
+// Remove the front item (shifts the rest; meant for short lists)
+template <class T, int N>
+inline void InlineVector<T, N>::pop_front() {
+	assert(count);
+	for (int i = 1; i < count; i++) {
+		items[i - 1] = items[i];
+	}
+	count--;
+}
+
+// Insert an item before the given position (shifts the rest)
+template <class T, int N>
+inline T* InlineVector<T, N>::insert(T* pos, const T& item) {
+	assert(count < N && begin() <= pos && pos <= end());
+	for (T* p = end(); p > pos; p--) {
+		*p = *(p - 1);
+	}
+	*pos = item;
+	count++;
+	return pos;
+}
+
+// Remove the item at the given position (shifts the rest)
+template <class T, int N>
+inline T* InlineVector<T, N>::erase(T* pos) {
+	assert(begin() <= pos && pos < end());
+	for (T* p = pos + 1; p < end(); p++) {
+		*(p - 1) = *p;
+	}
+	count--;
+	return pos;
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+	Name: MakeBoardData
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 17-10-26 10:30
+	Description: Build tool to compile the Search Board CSV files
+		into a header of constant data (SearchBoardData.h).
+		Rerun after any edit to the CSV files:
+			MakeBoardData [csvDir] > SearchBoardData.h
+*/
+#include <iostream>
+#include <iomanip>
+#include "SearchBoard.h"
+using namespace std;
+
+// Main driver
+int main(int argc, char** argv) {
+	string csvDir = argc > 1 ? argv[1] : "";
+	SearchBoard board(csvDir);
+	cout << "/*\n"
+		<< "\tName: SearchBoardData\n"
+		<< "\tDescription: Search Board layers as row bitmasks,\n"
+		<< "\t\tcompiled from SearchBoard-*.csv files (bit 0 = column 1).\n"
+		<< "\t\tGenerated by MakeBoardData; do not edit by hand.\n"
+		<< "*/\n"
+		<< "#ifndef SEARCHBOARDDATA_H\n"
+		<< "#define SEARCHBOARDDATA_H\n"
+		<< "#include <cstdint>\n\n"
+		<< "namespace SearchBoardData {\n\n"
+		<< "constexpr uint32_t LAYER_ROWS[" << SearchBoard::NUM_FILE_LAYERS
+		<< "][" << GridCoordinate::NUM_ROWS << "] = {\n";
+	cout << hex << setfill('0');
+	for (int layer = 0; layer < SearchBoard::NUM_FILE_LAYERS; layer++) {
+		auto& data = board.getLayer((SearchBoard::Layers) layer);
+		cout << "\t// " << data.getName() << "\n\t{";
+		for (int rowIdx = 0; rowIdx < GridCoordinate::NUM_ROWS; rowIdx++) {
+			uint32_t bits = 0;
+			for (int colIdx = 0; colIdx < GridCoordinate::NUM_COLS; colIdx++) {
+				GridCoordinate zone(GridCoordinate::MIN_ROW + rowIdx, 
+					GridCoordinate::MIN_COL + colIdx);
+				if (data.isBitOn(zone)) {
+					bits |= (1u << colIdx);
+				}
+			}
+			cout << (rowIdx % 6 ? " " : "\n\t\t")
+				<< "0x" << setw(8) << bits
+				<< (rowIdx < GridCoordinate::NUM_ROWS - 1 ? "," : "");
+		}
+		cout << "\n\t}" 
+			<< (layer < SearchBoard::NUM_FILE_LAYERS - 1 ? "," : "") << "\n";
+	}
+	cout << "};\n\n"
+		<< "}\n\n"
+		<< "#endif\n";
+	return 0;
+}
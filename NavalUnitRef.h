@@ -0,0 +1,97 @@
+/*
+	Name: NavalUnitRef
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 17-10-26 14:40
+	Description: Reference to one of our naval units, tagged
+		by its concrete type (solo Ship or TaskForce).
+		For the German phase loops: calls go straight to the
+		final class (inlined where possible) instead of through
+		the NavalUnit virtual table. Use get() for anything that
+		takes the general interface (e.g., the British player).
+*/
+#ifndef NAVALUNITREF_H
+#define NAVALUNITREF_H
+#include "Ship.h"
+#include "TaskForce.h"
+#include <cassert>
+#include <ostream>
+#include <string>
+
+class NavalUnitRef
+{
+	public:
+		// Construction
+		NavalUnitRef(Ship* ship): ship(ship), taskForce(nullptr)
+			{ assert(ship); }
+		NavalUnitRef(TaskForce* taskForce): ship(nullptr),
+			taskForce(taskForce) { assert(taskForce); }
+
+		// General interface
+		NavalUnit& get() const
+			{ return ship ? (NavalUnit&) *ship : *taskForce; }
+		bool isTaskForce() const { return !ship; }
+
+		// Descriptors
+		std::string getTypeDesc() const
+			{ return ship ? ship->getTypeDesc() : taskForce->getTypeDesc(); }
+		std::string getNameDesc() const
+			{ return ship ? ship->getNameDesc() : taskForce->getNameDesc(); }
+		std::string getFullDesc() const
+			{ return ship ? ship->getFullDesc() : taskForce->getFullDesc(); }
+		void printTypeDesc(std::ostream& stream) const {
+			if (ship) stream << ship->getTypeDesc();
+			else taskForce->printTypeDesc(stream); }
+		void printNameDesc(std::ostream& stream) const {
+			if (ship) stream << ship->getNameDesc();
+			else taskForce->printNameDesc(stream); }
+
+		// Accessors
+		Ship* getFlagship() const
+			{ return ship ? ship : taskForce->getFlagship(); }
+		GridCoordinate getPosition() const
+			{ return getFlagship()->getPosition(); }
+		int getSpeedThisTurn() const
+			{ return getFlagship()->getSpeedThisTurn(); }
+		int getSearchStrength() const { return ship ?
+			ship->getSearchStrength() : taskForce->getSearchStrength(); }
+
+		// Status checks
+		bool isAfloat() const
+			{ return ship ? ship->isAfloat() : taskForce->isAfloat(); }
+		bool isOnBoard() const
+			{ return ship ? ship->isOnBoard() : taskForce->isOnBoard(); }
+		bool isInNight() const { return getFlagship()->isInNight(); }
+		bool isInFog() const { return getFlagship()->isInFog(); }
+		bool isInPort() const { return getFlagship()->isInPort(); }
+		bool isReturnToBase() const
+			{ return getFlagship()->isReturnToBase(); }
+		bool isOnPatrol() const { return getFlagship()->isOnPatrol(); }
+		bool wasLocated(unsigned turnsAgo) const
+			{ return getFlagship()->wasLocated(turnsAgo); }
+		bool wasShadowed(unsigned turnsAgo) const
+			{ return getFlagship()->wasShadowed(turnsAgo); }
+		bool wasCombated(unsigned turnsAgo) const
+			{ return getFlagship()->wasCombated(turnsAgo); }
+		bool wasConvoySunk(unsigned turnsAgo) const { return ship ?
+			ship->wasConvoySunk(turnsAgo)
+			: taskForce->wasConvoySunk(turnsAgo); }
+		bool movedThrough(const GridCoordinate& zone) const
+			{ return getFlagship()->movedThrough(zone); }
+
+		// Mutators
+		void doMovementTurn() const { ship ? ship->doMovementTurn()
+			: taskForce->doMovementTurn(); }
+		void setLocated() const
+			{ ship ? ship->setLocated() : taskForce->setLocated(); }
+		void setConvoySunk() const
+			{ ship ? ship->setConvoySunk() : taskForce->setConvoySunk(); }
+		void setDetected() const
+			{ ship ? ship->setDetected() : taskForce->setDetected(); }
+
+	private:
+		Ship* ship;
+		TaskForce* taskForce;
+};
+
+#endif
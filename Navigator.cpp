@@ -1,88 +1,565 @@
 #include "Navigator.h"
-#include "Utils.h"
-#include <iostream>
-#include <vector>
-#include <unordered_map>
+#include "SearchBoard.h"
+#include "RandomStream.h"
+#include <cstdint>
+#include <cassert>
 #include <algorithm>
 using namespace std;
 
-// Structure to record path-search information
-struct ZonePathRecord {
-	bool inOpenSet;	
-	int gScore, fScore;	
-	GridCoordinate cameFrom;	
+// Workspace for searches over zones
+//   Flat arrays by zone index, one set per thread, reused each search.
+//   Marks are valid only if stamped with current generation,
+//   so no clearing needed between searches.
+//   Weighted search keeps a ring of buckets by key (Dial's method),
+//   each a linked list of entries in a flat pool;
+//   entries made stale by a cheaper cost are skipped when popped.
+//   (Safe route search reuses target marks for counted zones.)
+struct SearchWorkspace {
+	static const int NUM_ZONES = GridCoordinate::NUM_ZONES;
+	static const int MAX_BUCKETS = 32;
+	static const int MAX_ENTRIES = NUM_ZONES * SeaGraph::MAX_NEIGHBORS + 1;
+	uint32_t generation = 0;
+	uint32_t visitStamp[NUM_ZONES] = {0};
+	uint32_t targetStamp[NUM_ZONES] = {0};
+	uint32_t doneStamp[NUM_ZONES] = {0};
+	uint8_t distance[NUM_ZONES];
+	int cost[NUM_ZONES];
+	float routeSum[NUM_ZONES]; // weight of routes from next zones
+	int16_t queue[NUM_ZONES];
+	int16_t bucketHead[MAX_BUCKETS];
+	int16_t entryZone[MAX_ENTRIES];
+	int16_t entryNext[MAX_ENTRIES];
+
+	// Start a new search
+	void reset() {
+		if (++generation == 0) {
+			fill(visitStamp, visitStamp + NUM_ZONES, 0);
+			fill(targetStamp, targetStamp + NUM_ZONES, 0);
+			fill(doneStamp, doneStamp + NUM_ZONES, 0);
+			generation = 1;
+		}
+	}
+	bool isVisited(int zone) const { return visitStamp[zone] == generation; }
+	bool isTarget(int zone) const { return targetStamp[zone] == generation; }
+	bool isDone(int zone) const { return doneStamp[zone] == generation; }
+	int getDistance(int zone) const 
+		{ return isVisited(zone) ? distance[zone] : SeaGraph::UNREACHABLE; }
 };
+static thread_local SearchWorkspace workspace;
+
+// Workspace for timed route plans
+//   Zones in the plan listed compactly; states by turn, 
+//   then moved-fast flag, then plan zone. Vectors grow to the 
+//   largest plan made on the thread, then are reused.
+struct TimedWorkspace {
+	std::vector<int16_t> zones;
+	std::vector<int16_t> planIndex; // by board zone (-1 if none)
+	struct Reach {
+		int16_t plan; // plan zone...
+		int16_t dist; // ...its distance...
+		float routes; // ...& number of shortest routes there
+	};
+	std::vector<Reach> within; // plan zones in reach of each...
+	std::vector<int> withinStart; // ...from this offset
+	std::vector<uint8_t> reachDist; // by board zone, in one search
+	std::vector<int16_t> queue;
+	std::vector<int> cost;
+	std::vector<float> routeSum;
+	std::vector<int> endCost; // by turn & plan zone
+	std::vector<int> candidates; // states leading to one...
+	std::vector<float> weights; // ...& weight of routes via each
+	Navigator::Route leg; // route for one turn
+};
+static thread_local TimedWorkspace timedWorkspace;
+
+// Find a sea route from start to goal
+//   Picks uniformly among all the shortest routes;
+//   with zone weights, in proportion to the product of
+//   weights along each route (weights must be positive).
+//   Uses board's distance table unless some zones are 
+//   to be avoided or weighted.
+//   Route is empty if none exists, or start is goal.
+void Navigator::findSeaRoute(const SearchBoard& board, 
+	const GridCoordinate& start, const GridCoordinate& goal, 
+	RandomStream& random, Route& route,
+	const SearchBoardLayer* avoidZones, const float* zoneWeights)
+{
+	route.clear();
+	if (!start.isOnBoard() || !goal.isOnBoard()
+		|| !board.isGermanAccessible(goal))
+	{
+		return;
+	}
+	if (avoidZones || zoneWeights) {
+		searchSeaRoute(board, start.index(), goal.index(), 
+			avoidZones, zoneWeights, random, route);
+	}
+	else {
+		auto& graph = board.getSeaGraph();
+		int goalIdx = goal.index();
+		walkRoute(board, start.index(), goalIdx, 
+			[&](int zone) { 
+				int dist = graph.getDistance(zone, goalIdx);
+				return dist == SeaGraph::UNREACHABLE ? NO_ROUTE : dist; 
+			},
+			[&](int zone) { return graph.getNumRoutes(zone, goalIdx); },
+			random, route);
+	}
+}
 
-// Find a sea route via the A* search algorithm
-//   See: https://en.wikipedia.org/wiki/A*_search_algorithm
-//   Initial code from OpenAI chat suggestion.
-//   We add a decimal to keys in the priority queue,
-//     so as to randomly shuffle equally-close options.
-//   Returns route in reverse order (goal is first element).
-std::vector<GridCoordinate> Navigator::findSeaRoute(
-	const Ship& ship, const GridCoordinate& goal)
+// Find a sea route of least cost, weighing hazard of each zone
+//   Cost to enter a zone is base plus hazard times risk scale
+//   (never below 1); zero risk is just the shortest route.
+//   Picks uniformly among routes of equal cost.
+void Navigator::findSafeSeaRoute(const SearchBoard& board, 
+	const GridCoordinate& start, const GridCoordinate& goal, 
+	int riskScale, RandomStream& random, Route& route)
 {
-	// Create data structures
-	typedef pair<double, GridCoordinate> rankedZone;
-	priority_queue<rankedZone, vector<rankedZone>, greater<>> openSet;
-	unordered_map<GridCoordinate, ZonePathRecord, GridCoordinateHash> 
-		pathRecords;
-
-	// Initialize with ship start position
-	GridCoordinate start = ship.getPosition();
-	int distance = start.distanceFrom(goal);
-	pathRecords[start] = {true, 0, distance, GridCoordinate::OFFBOARD};
-	openSet.emplace(distance + randDecimal(), start);
-	
-	// While we have an open edge to the search space
-	while (!openSet.empty()) {
-
-		// Get the best-guess next step
-		GridCoordinate current = openSet.top().second;
-		pathRecords[current].inOpenSet = false;
-		openSet.pop();
-
-		// If we've found our goal, compile route & return
-		if (current == goal) {
-			vector<GridCoordinate> path;
-			while (current != start) {
-				path.push_back(current);
-				current = pathRecords[current].cameFrom;
-			}
-			return path;
-		}
-
-		// Search zones adjacent to current guess
-		auto nearbyList = current.getArea(1);
-		for (const auto& neighbor: nearbyList) {
-			if (neighbor == current 
-				|| !ship.isAccessible(neighbor)) 
+	assert(0 <= riskScale && riskScale <= MAX_RISK_SCALE);
+	if (riskScale == 0) {
+		findSeaRoute(board, start, goal, random, route);
+		return;
+	}
+	route.clear();
+	if (!start.isOnBoard() || !goal.isOnBoard()
+		|| !board.isGermanAccessible(goal))
+	{
+		return;
+	}
+	searchSafeRoute(board, start.index(), goal.index(), 
+		riskScale, random, route);
+}
+
+// Walk downhill on distance to goal, filling route
+//   Next step chosen in proportion to weight of routes onward
+//   (one random draw per step, and only if there is a choice)
+template <class DistanceFunc, class WeightFunc>
+void Navigator::walkRoute(const SearchBoard& board, int start, 
+	int goal, DistanceFunc distance, WeightFunc weight,
+	RandomStream& random, Route& route)
+{
+	auto& graph = board.getSeaGraph();
+	int current = start;
+	while (current != goal) {
+		int nextHops[SeaGraph::MAX_NEIGHBORS];
+		float hopWeights[SeaGraph::MAX_NEIGHBORS];
+		int numHops = 0;
+		int bestDist = NO_ROUTE;
+		for (int i = 0; i < graph.getNumNeighbors(current); i++) {
+			int neighbor = graph.getNeighbor(current, i);
+			int dist = distance(neighbor);
+			if (dist < bestDist) {
+				bestDist = dist;
+				numHops = 0;
+			}
+			if (dist == bestDist) {
+				nextHops[numHops++] = neighbor;
+			}
+		}
+
+		// Leave route empty if no path exists
+		if (bestDist == NO_ROUTE) {
+			route.clear();
+			return;
+		}
+
+		// Choose next step by weight
+		int choice = 0;
+		if (numHops > 1) {
+			double totalWeight = 0;
+			for (int i = 0; i < numHops; i++) {
+				hopWeights[i] = weight(nextHops[i]);
+				totalWeight += hopWeights[i];
+			}
+			double roll = random.randDecimal() * totalWeight;
+			while (choice < numHops - 1 && roll >= hopWeights[choice]) {
+				roll -= hopWeights[choice++];
+			}
+		}
+		current = nextHops[choice];
+		route.push_back(GridCoordinate::fromIndex(current));
+	}
+	reverse(route.begin(), route.end());
+}
+
+// Find a sea route avoiding or weighting some zones
+//   Breadth-first search out from goal, until the level
+//   holding the start's nearest neighbors is complete.
+//   Each zone finished passes its weight of routes on to 
+//   zones one step further out (as in SeaGraph route counts).
+void Navigator::searchSeaRoute(const SearchBoard& board, 
+	int start, int goal, const SearchBoardLayer* avoidZones, 
+	const float* zoneWeights, RandomStream& random, Route& route)
+{
+	auto& graph = board.getSeaGraph();
+	auto& work = workspace;
+	auto routeWeight = [&](int zone) { 
+		return zoneWeights ? zoneWeights[zone] * work.routeSum[zone] 
+			: work.routeSum[zone]; 
+	};
+	work.reset();
+	for (int i = 0; i < graph.getNumNeighbors(start); i++) {
+		work.targetStamp[graph.getNeighbor(start, i)] = work.generation;
+	}
+
+	// Search from goal
+	int head = 0, tail = 0;
+	int stopDist = SeaGraph::UNREACHABLE;
+	work.visitStamp[goal] = work.generation;
+	work.distance[goal] = 0;
+	work.routeSum[goal] = 1.0f;
+	work.queue[tail++] = goal;
+	if (work.isTarget(goal)) {
+		stopDist = 0;
+	}
+	while (head < tail) {
+		int zone = work.queue[head++];
+		if (work.distance[zone] >= stopDist) {
+			break;
+		}
+		float weight = routeWeight(zone);
+		for (int i = 0; i < graph.getNumNeighbors(zone); i++) {
+			int next = graph.getNeighbor(zone, i);
+			if (!work.isVisited(next)
+				&& !(avoidZones 
+					&& avoidZones->isBitOn(GridCoordinate::fromIndex(next))))
 			{
+				work.visitStamp[next] = work.generation;
+				work.distance[next] = work.distance[zone] + 1;
+				work.routeSum[next] = 0.0f;
+				work.queue[tail++] = next;
+				if (work.isTarget(next)) {
+					stopDist = min(stopDist, (int) work.distance[next]);
+				}
+			}
+			if (work.getDistance(next) == work.distance[zone] + 1) {
+				work.routeSum[next] += weight;
+			}
+		}
+	}
+	walkRoute(board, start, goal, 
+		[&](int zone) { 
+			return work.isVisited(zone) ? work.distance[zone] : NO_ROUTE; 
+		},
+		routeWeight, random, route);
+}
+
+// Find a sea route of least cost (see findSafeSeaRoute)
+//   A* search out from goal, in order of cost plus a lower bound 
+//   to the start (fewest moves at least cost per move; so search
+//   keys never decrease, and fit a small ring of buckets).
+//   Cost of a zone is to move from it to goal, so steps on the 
+//   route must add the cost to enter the next zone.
+//   Continues past the start until all keys as low are done, 
+//   so every zone on a least-cost route is done.
+void Navigator::searchSafeRoute(const SearchBoard& board, 
+	int start, int goal, int riskScale, RandomStream& random, Route& route)
+{
+	auto& graph = board.getSeaGraph();
+	auto& work = workspace;
+	int minCost = max(1, BASE_MOVE_COST - riskScale);
+	int maxCost = BASE_MOVE_COST + riskScale * SearchBoard::MAX_HAZARD;
+	int numBuckets = maxCost + minCost + 1;
+	assert(numBuckets <= SearchWorkspace::MAX_BUCKETS);
+	int boundScale = graph.isAccessible(start) ? minCost : 0;
+	auto bound = [&](int zone) { 
+		return boundScale * graph.getDistance(zone, start); 
+	};
+	work.reset();
+	fill(work.bucketHead, work.bucketHead + numBuckets, -1);
+	int numEntries = 0, numPending = 0;
+	auto push = [&](int zone, int key) {
+		assert(numEntries < SearchWorkspace::MAX_ENTRIES);
+		int bucket = key % numBuckets;
+		work.entryZone[numEntries] = zone;
+		work.entryNext[numEntries] = work.bucketHead[bucket];
+		work.bucketHead[bucket] = numEntries++;
+		numPending++;
+	};
+
+	// Search from goal
+	work.visitStamp[goal] = work.generation;
+	work.cost[goal] = 0;
+	push(goal, bound(goal));
+	int startCost = NO_ROUTE;
+	for (int key = bound(goal); numPending > 0 && key <= startCost; key++) {
+		auto& head = work.bucketHead[key % numBuckets];
+		while (head >= 0) {
+			int zone = work.entryZone[head];
+			head = work.entryNext[head];
+			numPending--;
+			if (work.isDone(zone) || work.cost[zone] + bound(zone) != key) {
+				continue;
+			}
+			work.doneStamp[zone] = work.generation;
+			if (zone == start) {
+				startCost = work.cost[zone];
+			}
+			int nextCost = work.cost[zone] 
+				+ getMoveCost(board, zone, riskScale);
+			for (int i = 0; i < graph.getNumNeighbors(zone); i++) {
+				int next = graph.getNeighbor(zone, i);
+				if (!work.isVisited(next) || nextCost < work.cost[next]) {
+					work.visitStamp[next] = work.generation;
+					work.cost[next] = nextCost;
+					push(next, nextCost + bound(next));
+				}
+			}
+		}
+	}
+
+	// Walk by least cost, counting routes on demand
+	auto viaCost = [&](int zone) { 
+		return work.isDone(zone) ? 
+			work.cost[zone] + getMoveCost(board, zone, riskScale) 
+			: NO_ROUTE; 
+	};
+	walkRoute(board, start, goal, viaCost,
+		[&](int zone) { return countLeastRoutes(board, zone, goal, viaCost); },
+		random, route);
+}
+
+// Count least-cost routes from zone to goal (for safe route walk)
+//   Sum over next zones on such routes; memo in route sums.
+template <class CostFunc>
+float Navigator::countLeastRoutes(const SearchBoard& board, 
+	int zone, int goal, CostFunc viaCost)
+{
+	auto& graph = board.getSeaGraph();
+	auto& work = workspace;
+	if (zone == goal) {
+		return 1.0f;
+	}
+	if (!work.isTarget(zone)) {
+		float count = 0.0f;
+		for (int i = 0; i < graph.getNumNeighbors(zone); i++) {
+			int next = graph.getNeighbor(zone, i);
+			if (viaCost(next) == work.cost[zone]) {
+				count += countLeastRoutes(board, next, goal, viaCost);
+			}
+		}
+		work.routeSum[zone] = count;
+		work.targetStamp[zone] = work.generation;
+	}
+	return work.routeSum[zone];
+}
+
+// Find a sea route timed turn by turn
+//   Time-expanded search over states (turn, moved fast, zone):
+//   each turn a ship makes up to maxMoves moves (or stays), 
+//   then pays turnCost for the zone it ends in (at least 1).
+//   Knowing future costs (e.g., night) lets it wait or hurry.
+//   Ties in cost go to fewest total moves (so slack turns wait).
+//   Zones limited to modest detours from shortest routes.
+//   Turns counted from now (0 = this turn), up to plan maximum.
+//   Fills route (goal first) & moves per turn (last turn first).
+//   Returns false if start or goal inaccessible, goal too far,
+//   or route longer than Route holds.
+bool Navigator::findTimedSeaRoute(const SearchBoard& board, 
+	const GridCoordinate& start, const GridCoordinate& goal, 
+	bool movedFast, TurnMovesFunc maxMoves, TurnCostFunc turnCost,
+	RandomStream& random, Route& route, TurnMoves& turnMoves)
+{
+	route.clear();
+	turnMoves.clear();
+	if (!start.isOnBoard() || !goal.isOnBoard()
+		|| !board.isGermanAccessible(start)
+		|| !board.isGermanAccessible(goal))
+	{
+		return false;
+	}
+	auto& graph = board.getSeaGraph();
+	auto& work = timedWorkspace;
+	int startIdx = start.index(), goalIdx = goal.index();
+	int directDist = graph.getDistance(startIdx, goalIdx);
+	if (directDist == SeaGraph::UNREACHABLE || startIdx == goalIdx) {
+		return false;
+	}
+
+	// List zones in plan
+	int maxDist = directDist + MAX_PLAN_DETOUR;
+	work.zones.clear();
+	work.planIndex.assign(GridCoordinate::NUM_ZONES, -1);
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		if (graph.isAccessible(i) 
+			&& graph.getDistance(i, startIdx) 
+				+ graph.getDistance(i, goalIdx) <= maxDist)
+		{
+			work.planIndex[i] = work.zones.size();
+			work.zones.push_back(i);
+		}
+	}
+
+	// List plan zones within reach of each, nearest first
+	//   (reach is the most moves on any turn)
+	int reach = 0;
+	for (int turn = 0; turn < MAX_PLAN_TURNS; turn++) {
+		reach = max(reach, max(maxMoves(turn, false), maxMoves(turn, true)));
+	}
+	assert(reach * MAX_PLAN_TURNS < MOVE_TIE_SCALE);
+	//   By breadth-first search out to reach from each
+	int numZones = work.zones.size();
+	work.within.clear();
+	work.withinStart.assign(numZones + 1, 0);
+	work.reachDist.assign(GridCoordinate::NUM_ZONES, SeaGraph::UNREACHABLE);
+	work.queue.resize(GridCoordinate::NUM_ZONES);
+	for (int i = 0; i < numZones; i++) {
+		work.withinStart[i] = work.within.size();
+		int head = 0, tail = 0;
+		work.queue[tail++] = work.zones[i];
+		work.reachDist[work.zones[i]] = 0;
+		while (head < tail) {
+			int zone = work.queue[head++];
+			if (work.planIndex[zone] >= 0) {
+				work.within.push_back({work.planIndex[zone], 
+					work.reachDist[zone], 
+					graph.getNumRoutes(work.zones[i], zone)});
+			}
+			if (work.reachDist[zone] == reach) {
 				continue;
 			}
+			for (int k = 0; k < graph.getNumNeighbors(zone); k++) {
+				int next = graph.getNeighbor(zone, k);
+				if (work.reachDist[next] == SeaGraph::UNREACHABLE) {
+					work.reachDist[next] = work.reachDist[zone] + 1;
+					work.queue[tail++] = next;
+				}
+			}
+		}
+		for (int k = 0; k < tail; k++) {
+			work.reachDist[work.queue[k]] = SeaGraph::UNREACHABLE;
+		}
+	}
+	work.withinStart[numZones] = work.within.size();
 
-			// Compute distance from start to this neighbor
-			int tentative_gScore = pathRecords[current].gScore + 1;
+	// Find least cost to each state, turn by turn,
+	//   with weight of routes of that cost (as in SeaGraph counts).
+	//   Cost is scaled turn costs plus moves, so moves break ties.
+	//   Goal states are final; stop when no other state is cheaper.
+	int layerSize = 2 * numZones;
+	auto state = [&](int turn, bool fast, int i) 
+		{ return (turn * 2 + fast) * numZones + i; };
+	work.cost.assign((MAX_PLAN_TURNS + 1) * layerSize, (int) NO_ROUTE);
+	work.routeSum.assign((MAX_PLAN_TURNS + 1) * layerSize, 0.0f);
+	int first = state(0, movedFast, work.planIndex[startIdx]);
+	work.cost[first] = 0;
+	work.routeSum[first] = 1.0f;
+	int goalPlan = work.planIndex[goalIdx];
+	int bestCost = NO_ROUTE, bestState = -1;
+	work.endCost.assign(MAX_PLAN_TURNS * numZones, 0);
+	for (int turn = 0; turn < MAX_PLAN_TURNS; turn++) {
+		int* endCost = &work.endCost[turn * numZones];
+		int leastOpen = NO_ROUTE;
+		for (int fast = 0; fast < 2; fast++) {
+			int moves = maxMoves(turn, fast);
+			for (int i = 0; i < numZones; i++) {
+				int from = state(turn, fast, i);
+				int fromCost = work.cost[from];
+				if (fromCost == NO_ROUTE || i == goalPlan) {
+					continue;
+				}
+				for (int k = work.withinStart[i]; 
+					k < work.withinStart[i + 1]; k++)
+				{
+					auto& reached = work.within[k];
+					if (reached.dist > moves) {
+						break;
+					}
+					int to = state(turn + 1, reached.dist > 1, reached.plan);
+					if (!endCost[reached.plan]) { // not yet found
+						endCost[reached.plan] = turnCost(
+							work.zones[reached.plan], turn);
+						assert(endCost[reached.plan] >= 1);
+					}
+					int toCost = fromCost 
+						+ endCost[reached.plan] * MOVE_TIE_SCALE + reached.dist;
+					float routes = work.routeSum[from] * reached.routes;
+					if (toCost < work.cost[to]) {
+						work.cost[to] = toCost;
+						work.routeSum[to] = routes;
+					}
+					else if (toCost == work.cost[to]) {
+						work.routeSum[to] += routes;
+					}
+				}
+			}
+		}
+		for (int fast = 0; fast < 2; fast++) {
+			for (int i = 0; i < numZones; i++) {
+				int cost = work.cost[state(turn + 1, fast, i)];
+				if (i == goalPlan && cost < bestCost) {
+					bestCost = cost;
+					bestState = state(turn + 1, fast, i);
+				}
+				else if (i != goalPlan) {
+					leastOpen = min(leastOpen, cost);
+				}
+			}
+		}
+		if (leastOpen >= bestCost) {
+			break;
+		}
+	}
+	if (bestState < 0 || bestCost % MOVE_TIE_SCALE > MAX_ROUTE) {
+		return false;
+	}
 
-			// Record if this is the shortest path found to neighbor
-			if (pathRecords.find(neighbor) == pathRecords.end()
-				|| tentative_gScore < pathRecords[neighbor].gScore) 
+	// Trace back, picking each turn's start in proportion to
+	//   weight of routes through it, then moves within the turn
+	//   (so uniform among routes of least cost, as in findSeaRoute)
+	int to = bestState;
+	for (int turn = bestState / layerSize - 1; turn >= 0; turn--) {
+		int j = to % numZones;
+		bool toFast = (to / numZones) % 2;
+		int endCost = work.endCost[turn * numZones + j] * MOVE_TIE_SCALE;
+		auto& candidates = work.candidates;
+		auto& weights = work.weights;
+		candidates.clear();
+		weights.clear();
+		double totalWeight = 0;
+		for (int fast = 0; fast < 2; fast++) {
+			int moves = maxMoves(turn, fast);
+			for (int k = work.withinStart[j]; 
+				k < work.withinStart[j + 1]; k++)
 			{
-				pathRecords[neighbor].cameFrom = current;
-				pathRecords[neighbor].gScore = tentative_gScore;
-				pathRecords[neighbor].fScore = tentative_gScore 
-					+ neighbor.distanceFrom(goal);
-
-				// Add new zone to open set
-				if (!pathRecords[neighbor].inOpenSet) {
-					openSet.emplace(pathRecords[neighbor].fScore 
-						+ randDecimal(), neighbor);
-					pathRecords[neighbor].inOpenSet = true;
+				auto& reached = work.within[k];
+				if (reached.dist > moves) {
+					break;
+				}
+				int from = state(turn, fast, reached.plan);
+				if ((reached.dist > 1) == toFast 
+					&& reached.plan != goalPlan
+					&& work.cost[from] != NO_ROUTE
+					&& work.cost[from] + endCost + reached.dist == work.cost[to])
+				{
+					candidates.push_back(from);
+					weights.push_back(work.routeSum[from] * reached.routes);
+					totalWeight += weights.back();
 				}
 			}
 		}
+		assert(!candidates.empty());
+		int choice = 0;
+		if (candidates.size() > 1) {
+			double roll = random.randDecimal() * totalWeight;
+			while (choice < (int) candidates.size() - 1 
+				&& roll >= weights[choice]) 
+			{
+				roll -= weights[choice++];
+			}
+		}
+		int from = candidates[choice];
+		int zone = work.zones[from % numZones], toZone = work.zones[j];
+		turnMoves.push_back(graph.getDistance(zone, toZone));
+		work.leg.clear();
+		walkRoute(board, zone, toZone, 
+			[&](int next) { return graph.getDistance(next, toZone); },
+			[&](int next) { return graph.getNumRoutes(next, toZone); },
+			random, work.leg);
+		for (auto& zone: work.leg) {
+			route.push_back(zone);
+		}
+		to = from;
 	}
-
-	// Return an empty path if no path is found
-	return {};
+	return true;
 }
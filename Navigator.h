@@ -3,19 +3,91 @@
 	Copyright: 2024
 	Author: Daniel R. Collins
 	Date: 29-12-24 22:19
-	Description: Provide variant A* pathfinding algorithm.
-		Returns route in reverse order (goal is first element).
+	Description: Find sea routes for German ships.
+		Normally walks the board's precomputed distance table.
+		Routes avoiding or weighting some zones need a fresh 
+		breadth-first search; that runs in flat arrays reused by 
+		each thread (no allocation).
+		Steps are chosen in proportion to the number of shortest
+		routes through each, so every shortest route is equally likely
+		(or, with zone weights, likely as the product of its weights).
+		Safe routes weigh each zone by its hazard on the board,
+		by A* search on a bucket queue (costs are small integers).
+		Timed routes plan moves turn by turn against costs that
+		change over time (e.g., night), so may wait or hurry.
+		Fills route in reverse order (goal is first element).
 */
 #ifndef NAVIGATOR_H
 #define NAVIGATOR_H
-#include "Ship.h"
+#include "GridCoordinate.h"
+#include "SearchBoard.h"
+#include "InlineVector.h"
 #include <vector>
+#include <climits>
+#include <functional>
+
+// Forwards
+class RandomStream;
 
 class Navigator
 {
 	public:
-		static std::vector<GridCoordinate> findSeaRoute(
-			const Ship& ship, const GridCoordinate& goal);
+		// Constants
+		static const int BASE_MOVE_COST = 4;
+		static const int MAX_RISK_SCALE = 4;
+		static const int MAX_PLAN_TURNS = 30;
+		static const int MAX_PLAN_DETOUR = 2;
+		static const int MAX_ROUTE = 64;
+
+		// Routes held inline (longest safe route on board is 41;
+		// timed routes any longer are refused)
+		typedef InlineVector<GridCoordinate, MAX_ROUTE> Route;
+		typedef InlineVector<int, MAX_PLAN_TURNS> TurnMoves;
+
+		static void findSeaRoute(const SearchBoard& board, 
+			const GridCoordinate& start, const GridCoordinate& goal, 
+			RandomStream& random, Route& route,
+			const SearchBoardLayer* avoidZones = nullptr,
+			const float* zoneWeights = nullptr);
+		static void findSafeSeaRoute(const SearchBoard& board, 
+			const GridCoordinate& start, const GridCoordinate& goal, 
+			int riskScale, RandomStream& random, Route& route);
+		static int getMoveCost(const SearchBoard& board, 
+			int zone, int riskScale);
+
+		// Timed routes: moves allowed on a turn (from now, 
+		// and if moved fast last turn), & cost to end a turn in a zone
+		typedef std::function<int(int turn, bool movedFast)> TurnMovesFunc;
+		typedef std::function<int(int zone, int turn)> TurnCostFunc;
+		static bool findTimedSeaRoute(const SearchBoard& board, 
+			const GridCoordinate& start, const GridCoordinate& goal, 
+			bool movedFast, TurnMovesFunc maxMoves, TurnCostFunc turnCost,
+			RandomStream& random, Route& route, TurnMoves& turnMoves);
+
+	private:
+		static const int NO_ROUTE = INT_MAX;
+		static const int MOVE_TIE_SCALE = 256;
+		template <class DistanceFunc, class WeightFunc>
+		static void walkRoute(const SearchBoard& board, int start, 
+			int goal, DistanceFunc distance, WeightFunc weight,
+			RandomStream& random, Route& route);
+		static void searchSeaRoute(const SearchBoard& board, 
+			int start, int goal, const SearchBoardLayer* avoidZones, 
+			const float* zoneWeights, RandomStream& random, 
+			Route& route);
+		static void searchSafeRoute(const SearchBoard& board, 
+			int start, int goal, int riskScale, RandomStream& random, Route& route);
+		template <class CostFunc>
+		static float countLeastRoutes(const SearchBoard& board, 
+			int zone, int goal, CostFunc viaCost);
 };
 
+// Get cost to move into a zone (by index)
+inline int Navigator::getMoveCost(const SearchBoard& board, 
+	int zone, int riskScale)
+{
+	int cost = BASE_MOVE_COST + riskScale * board.getHazard(zone);
+	return cost < 1 ? 1 : cost;
+}
+
 #endif
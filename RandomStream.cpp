@@ -0,0 +1,83 @@
+#include "RandomStream.h"
+
+// Philox constants
+//   See: Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"
+const uint32_t PHILOX_M0 = 0xD2511F53;
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+const int PHILOX_ROUNDS = 10;
+
+// Constructor
+//   Key is the seed & stream number; counter words 2-3 hold 
+//   the game index, and words 0-1 count blocks
+RandomStream::RandomStream(uint32_t seed, uint64_t gameIndex, 
+	uint32_t streamId)
+{
+	key[0] = seed;
+	key[1] = streamId;
+	counter[0] = 0;
+	counter[1] = 0;
+	counter[2] = (uint32_t) gameIndex;
+	counter[3] = (uint32_t) (gameIndex >> 32);
+	blockPos = BLOCK_SIZE;
+}
+
+// Encrypt the counter to make the next block of output
+void RandomStream::generateBlock() {
+	uint32_t c0 = counter[0], c1 = counter[1];
+	uint32_t c2 = counter[2], c3 = counter[3];
+	uint32_t k0 = key[0], k1 = key[1];
+	for (int round = 0; round < PHILOX_ROUNDS; round++) {
+		uint64_t prod0 = (uint64_t) PHILOX_M0 * c0;
+		uint64_t prod1 = (uint64_t) PHILOX_M1 * c2;
+		c0 = (uint32_t) (prod1 >> 32) ^ c1 ^ k0;
+		c1 = (uint32_t) prod1;
+		c2 = (uint32_t) (prod0 >> 32) ^ c3 ^ k1;
+		c3 = (uint32_t) prod0;
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+	}
+	block[0] = c0;
+	block[1] = c1;
+	block[2] = c2;
+	block[3] = c3;
+	blockPos = 0;
+	if (++counter[0] == 0) {
+		counter[1]++;
+	}
+}
+
+// Get the next raw 32-bit value
+uint32_t RandomStream::next() {
+	if (blockPos == BLOCK_SIZE) {
+		generateBlock();
+	}
+	return block[blockPos++];
+}
+
+// Randomize a number from 0 to 1 (exclusive)
+double RandomStream::randDecimal() {
+	return next() / 4294967296.0;
+}
+
+// Randomize a number from 0 to bound (exclusive)
+//   Scale by multiply & shift, not modulus (Lemire 2019)
+int RandomStream::rand(int bound) {
+	assert(bound > 0);
+	return (int) (((uint64_t) next() * bound) >> 32);
+}
+
+// Roll one die.
+int RandomStream::dieRoll(int sides) {
+	return rand(sides) + 1;
+}
+
+// Roll several dice and sum.
+int RandomStream::diceRoll(int num, int sides) {
+	int sum = 0;
+	for (int i = 0; i < num; i++) {
+		sum += dieRoll(sides);
+	}
+	return sum;
+}
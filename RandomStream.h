@@ -0,0 +1,45 @@
+/*
+	Name: RandomStream
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 16-10-26 18:40
+	Description: Source of random numbers for one game.
+		Counter-based generator (Philox4x32-10; Salmon et al. 2011),
+		keyed by a master seed, the game's index in a series,
+		and a stream number (so separate uses don't share numbers).
+		So any game can be replayed exactly, on any thread.
+*/
+#ifndef RANDOMSTREAM_H
+#define RANDOMSTREAM_H
+#include <cstdint>
+#include <vector>
+#include <cassert>
+
+class RandomStream
+{
+	public:
+		RandomStream(uint32_t seed = 0, uint64_t gameIndex = 0,
+			uint32_t streamId = 0);
+		uint32_t next();
+		double randDecimal();
+		int rand(int bound);
+		int dieRoll(int sides);
+		int diceRoll(int num, int sides);
+
+		// Get random element from a vector
+		template<class T>
+		T randomElem(const std::vector<T>& vec) {
+			assert(vec.size() > 0);
+			return vec[rand(vec.size())];
+		}
+
+	private:
+		static const int BLOCK_SIZE = 4;
+		uint32_t key[2];
+		uint32_t counter[BLOCK_SIZE];
+		uint32_t block[BLOCK_SIZE];
+		int blockPos;
+		void generateBlock();
+};
+
+#endif
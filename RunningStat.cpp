@@ -0,0 +1,67 @@
+#include "RunningStat.h"
+#include <cmath>
+using namespace std;
+
+// Add one sample
+void RunningStat::add(double x) {
+	count++;
+	double delta = x - mean;
+	mean += delta / count;
+	sumSqDev += delta * (x - mean);
+}
+
+// Combine another set of samples into this one
+void RunningStat::merge(const RunningStat& other) {
+	if (other.count == 0) {
+		return;
+	}
+	long total = count + other.count;
+	double delta = other.mean - mean;
+	mean += delta * other.count / total;
+	sumSqDev += other.sumSqDev 
+		+ delta * delta * count * other.count / total;
+	count = total;
+}
+
+// Get sample variance
+double RunningStat::getVariance() const {
+	return count > 1 ? sumSqDev / (count - 1) : 0.0;
+}
+
+// Get standard error of the mean
+double RunningStat::getStdError() const {
+	return count > 0 ? sqrt(getVariance() / count) : 0.0;
+}
+
+// Get half-width of normal confidence interval for the mean
+double RunningStat::getHalfWidth() const {
+	return Z_95 * getStdError();
+}
+
+// Get center of Wilson score interval
+double RunningStat::getWilsonCenter() const {
+	double zSq = Z_95 * Z_95;
+	return (mean + zSq / (2 * count)) / (1 + zSq / count);
+}
+
+// Get half-width of Wilson score interval
+//   Unlike the normal interval, stays honest near 0 or 1
+double RunningStat::getWilsonHalfWidth() const {
+	if (count == 0) {
+		return 1.0;
+	}
+	double zSq = Z_95 * Z_95;
+	double spread = mean * (1 - mean) / count 
+		+ zSq / (4.0 * count * count);
+	return Z_95 * sqrt(spread) / (1 + zSq / count);
+}
+
+// Get low end of Wilson score interval
+double RunningStat::getWilsonLow() const {
+	return count > 0 ? getWilsonCenter() - getWilsonHalfWidth() : 0.0;
+}
+
+// Get high end of Wilson score interval
+double RunningStat::getWilsonHigh() const {
+	return count > 0 ? getWilsonCenter() + getWilsonHalfWidth() : 1.0;
+}
@@ -0,0 +1,40 @@
+/*
+	Name: RunningStat
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 16-10-26 21:10
+	Description: Online mean & variance of one statistic,
+		updated one sample at a time (Welford 1962).
+		Partial stats from separate threads can be merged
+		(Chan, Golub & LeVeque 1979).
+		Also gives 95% confidence intervals: normal, 
+		or Wilson score for proportions (samples all 0 or 1).
+*/
+#ifndef RUNNINGSTAT_H
+#define RUNNINGSTAT_H
+
+class RunningStat
+{
+	public:
+		void add(double x);
+		void merge(const RunningStat& other);
+		long getCount() const { return count; }
+		double getMean() const { return mean; }
+		double getVariance() const;
+		double getStdError() const;
+		double getHalfWidth() const;
+		double getWilsonLow() const;
+		double getWilsonHigh() const;
+		double getWilsonHalfWidth() const;
+
+		// Critical value for 95% confidence
+		static constexpr double Z_95 = 1.96;
+
+	private:
+		long count = 0;
+		double mean = 0.0;
+		double sumSqDev = 0.0;
+		double getWilsonCenter() const;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "SeaGraph.h"
+#include <cassert>
+using namespace std;
+
+// Build the graph from a layer of accessible zones
+//   Neighbors listed for every zone (even if itself inaccessible),
+//   so a route can start from a port or other inaccessible zone.
+void SeaGraph::build(const SearchBoardLayer& layer) {
+	const int NUM_ZONES = GridCoordinate::NUM_ZONES;
+	accessibleZones = layer;
+	for (int i = 0; i < NUM_ZONES; i++) {
+		accessible[i] = layer.isBitOn(GridCoordinate::fromIndex(i));
+	}
+	for (int i = 0; i < NUM_ZONES; i++) {
+		auto zone = GridCoordinate::fromIndex(i);
+		numNeighbors[i] = 0;
+		for (auto& near: zone.getArea(1)) {
+			if (near != zone && near.isOnBoard() 
+				&& accessible[near.index()]) 
+			{
+				assert(numNeighbors[i] < MAX_NEIGHBORS);
+				neighbors[i][numNeighbors[i]++] = near.index();
+			}
+		}
+	}
+	distance.assign(NUM_ZONES * NUM_ZONES, UNREACHABLE);
+	numRoutes.assign(NUM_ZONES * NUM_ZONES, 0.0f);
+	for (int goal = 0; goal < NUM_ZONES; goal++) {
+		if (accessible[goal]) {
+			findDistancesTo(goal);
+		}
+	}
+}
+
+// Find distances to one goal from all accessible zones
+//   Breadth-first search outward from goal (moves are symmetric).
+//   Zones are finished in order of distance, so each adds its
+//   route count to the zones one step further out.
+//   (Counts are floats: they overflow integers on long routes.)
+void SeaGraph::findDistancesTo(int goal) {
+	uint8_t* dist = &distance[goal * GridCoordinate::NUM_ZONES];
+	float* routes = &numRoutes[goal * GridCoordinate::NUM_ZONES];
+	int16_t queue[GridCoordinate::NUM_ZONES];
+	int head = 0, tail = 0;
+	dist[goal] = 0;
+	routes[goal] = 1.0f;
+	queue[tail++] = goal;
+	while (head < tail) {
+		int zone = queue[head++];
+		for (int i = 0; i < numNeighbors[zone]; i++) {
+			int next = neighbors[zone][i];
+			if (dist[next] == UNREACHABLE) {
+				assert(dist[zone] + 1 < UNREACHABLE);
+				dist[next] = dist[zone] + 1;
+				queue[tail++] = next;
+			}
+			if (dist[next] == dist[zone] + 1) {
+				routes[next] += routes[zone];
+			}
+		}
+	}
+}
+
+// Find distances from all zones to the nearest source zone
+//   Breadth-first search outward from every accessible source at once,
+//   a ring of zones at a time (see SearchBoardLayer::findRings);
+//   each zone takes its nearest from the ring before, and
+//   ties go to the source first in index order.
+//   Inaccessible zones get one more than their nearest neighbor
+//   (as a route may start there), else are unreachable.
+void SeaGraph::findDistanceField(const SearchBoardLayer& sources, 
+	DistanceField& field) const
+{
+	const int NUM_ZONES = GridCoordinate::NUM_ZONES;
+	for (int i = 0; i < NUM_ZONES; i++) {
+		field.distance[i] = UNREACHABLE;
+		field.nearest[i] = -1;
+	}
+	auto rings = (sources & accessibleZones).findRings(accessibleZones);
+	assert(rings.size() < UNREACHABLE);
+	for (int dist = 0; dist < (int) rings.size(); dist++) {
+		for (auto& zone: rings[dist].getAllOn()) {
+			int idx = zone.index();
+			field.distance[idx] = dist;
+			field.nearest[idx] = dist ? NUM_ZONES : idx;
+			for (int i = 0; dist && i < numNeighbors[idx]; i++) {
+				int near = neighbors[idx][i];
+				if (field.distance[near] == dist - 1) {
+					field.nearest[idx] = min(field.nearest[idx], 
+						field.nearest[near]);
+				}
+			}
+		}
+	}
+	for (int i = 0; i < NUM_ZONES; i++) {
+		if (!accessible[i]) {
+			for (int j = 0; j < numNeighbors[i]; j++) {
+				int near = neighbors[i][j];
+				if (field.distance[near] + 1 < field.distance[i]) {
+					field.distance[i] = field.distance[near] + 1;
+					field.nearest[i] = field.nearest[near];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,57 @@
+/*
+	Name: SeaGraph
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 17-10-26 12:40
+	Description: Graph of moves between zones on the search board.
+		Built once from a layer of zones ships may enter:
+		the accessible neighbors of each zone, and the number of
+		moves from every zone to every goal (by breadth-first search),
+		with the count of shortest routes (for uniform sampling).
+		Also finds fields of distance to the nearest of a set of zones
+		(multi-source breadth-first search on layer bitmasks),
+		noting which is nearest.
+		Unlike GridCoordinate::distanceFrom, these go around land.
+		Zones are given by dense index (GridCoordinate::index).
+*/
+#ifndef SEAGRAPH_H
+#define SEAGRAPH_H
+#include "GridCoordinate.h"
+#include "SearchBoardLayer.h"
+#include <cstdint>
+#include <vector>
+
+class SeaGraph
+{
+	public:
+		static const int MAX_NEIGHBORS = 6;
+		static const int UNREACHABLE = UINT8_MAX;
+
+		// Distance to nearest of some zones, & which (by zone index)
+		struct DistanceField {
+			uint8_t distance[GridCoordinate::NUM_ZONES];
+			int16_t nearest[GridCoordinate::NUM_ZONES];
+		};
+
+		void build(const SearchBoardLayer& accessible);
+		bool isAccessible(int zone) const { return accessible[zone]; }
+		int getNumNeighbors(int zone) const { return numNeighbors[zone]; }
+		int getNeighbor(int zone, int i) const { return neighbors[zone][i]; }
+		int getDistance(int zone, int goal) const 
+			{ return distance[goal * GridCoordinate::NUM_ZONES + zone]; }
+		float getNumRoutes(int zone, int goal) const
+			{ return numRoutes[goal * GridCoordinate::NUM_ZONES + zone]; }
+		void findDistanceField(const SearchBoardLayer& sources, 
+			DistanceField& field) const;
+
+	private:
+		bool accessible[GridCoordinate::NUM_ZONES] = {false};
+		SearchBoardLayer accessibleZones;
+		uint8_t numNeighbors[GridCoordinate::NUM_ZONES] = {0};
+		int16_t neighbors[GridCoordinate::NUM_ZONES][MAX_NEIGHBORS];
+		std::vector<uint8_t> distance; // by goal, then zone
+		std::vector<float> numRoutes; // by goal, then zone
+		void findDistancesTo(int goal);
+};
+
+#endif
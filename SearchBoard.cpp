@@ -1,20 +1,80 @@
 #include "SearchBoard.h"
+#include "SearchBoardData.h"
+#include "RandomStream.h"
 #include "Utils.h"
 #include <cassert>
 
-// Singleton instance
-SearchBoard* SearchBoard::theInstance = nullptr;
+// Names of layers from files (in enum order)
+const char* const SearchBoard::FILE_LAYER_NAMES[NUM_FILE_LAYERS] = {
+	"SeaZones", "BritishCoast", "BritishPorts", "GermanPorts",
+	"FogZones", "IrishSea", "BritishPatrol", "ConvoyRoutes"
+};
 
-// Singleton instance accessor
-SearchBoard* SearchBoard::instance() {
-	if (!theInstance) {
-		theInstance = new SearchBoard;
+// Constructor from compiled data
+SearchBoard::SearchBoard() {
+	for (int layer = 0; layer < NUM_FILE_LAYERS; layer++) {
+		layers[layer] = SearchBoardLayer(FILE_LAYER_NAMES[layer],
+			SearchBoardData::LAYER_ROWS[layer]);
 	}
-	return theInstance;
+	deriveAll();
 }
 
-// Constructor
-SearchBoard::SearchBoard() {
+// Constructor from CSV files (e.g., to try board edits)
+//   Files named like SearchBoard-SeaZones.csv
+SearchBoard::SearchBoard(const std::string& csvDir) {
+	std::string prefix = csvDir;
+	if (!prefix.empty() 
+		&& prefix.back() != '/' && prefix.back() != '\\') 
+	{
+		prefix += '/';
+	}
+	for (int layer = 0; layer < NUM_FILE_LAYERS; layer++) {
+		auto name = FILE_LAYER_NAMES[layer];
+		layers[layer] = SearchBoardLayer(name,
+			prefix + "SearchBoard-" + name + ".csv");
+	}
+	deriveAll();
+}
+
+// Derive data from the file layers
+//   Derive layers first, then zones near each layer,
+//   then the general search table (which uses near zones),
+//   then the sea graph & distance fields over it
+void SearchBoard::deriveAll() {
+	deriveLayer(InsidePatrol, "Inside patrol line",
+		[this](const GridCoordinate& zone) 
+			{ return calcInsidePatrolLine(zone); });
+	deriveLayer(GermanAccessible, "German accessible",
+		[this](const GridCoordinate& zone) 
+			{ return calcGermanAccessible(zone); });
+	for (int layer = 0; layer < NUM_LAYERS; layer++) {
+		nearLayers[layer][0] = layers[layer].dilate();
+		for (int dist = 1; dist < MAX_NEAR_DISTANCE; dist++) {
+			nearLayers[layer][dist] = nearLayers[layer][dist - 1].dilate();
+		}
+	}
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		auto zone = GridCoordinate::fromIndex(i);
+		generalSearchColumn[i] = calcGeneralSearchColumn(zone);
+		hazard[i] = calcHazard(zone);
+	}
+	seaGraph.build(layers[GermanAccessible]);
+	seaGraph.findDistanceField(layers[ConvoyRoutes], 
+		destFields[ToConvoyRoutes]);
+	seaGraph.findDistanceField(layers[GermanPorts], 
+		destFields[ToGermanPorts]);
+	SearchBoardLayer rowZ("Row Z", [](const GridCoordinate& zone) 
+		{ return zone.getRow() == GridCoordinate::MAX_ROW; });
+	seaGraph.findDistanceField(rowZ, destFields[ToRowZ]);
+}
+
+// Declare a layer derived from others
+//   Rule is applied once to each zone on board
+void SearchBoard::deriveLayer(Layers layer, const char* name,
+	std::function<bool(const GridCoordinate&)> rule)
+{
+	assert(layer >= NUM_FILE_LAYERS);
+	layers[layer] = SearchBoardLayer(name, rule);
 }
 
 // Print all layers (for testing)
@@ -66,29 +126,43 @@ bool SearchBoard::isConvoyRoute(const GridCoordinate& zone) const {
 
 // Get a random sea zone within a given area
 //   Area is defined by center zone and radius (inclusive)
-GridCoordinate SearchBoard::randSeaZone(
-	const GridCoordinate& center, int radius) const
+GridCoordinate SearchBoard::randSeaZone(const GridCoordinate& center, 
+	int radius, RandomStream& random) const
 {
-	std::vector<GridCoordinate> seaZones;
-	auto area = center.getArea(radius);
-	for (auto zone: area) {
-		if (isSeaZone(zone)) {
-			seaZones.push_back(zone);
-		}
+	SearchBoardLayer area;
+	area.setBitOn(center);
+	for (int i = 0; i < radius; i++) {
+		area = area.dilate();
 	}
-	assert(!seaZones.empty());
-	return randomElem(seaZones);
+	return (area & layers[SeaZones]).randZoneOn(random);
+}
+
+// Get zones German ships can reach by sea in given moves or less
+//   (includes start zone, unless it is a port)
+SearchBoardLayer SearchBoard::getReach(const GridCoordinate& start, 
+	int moves) const
+{
+	SearchBoardLayer zones;
+	zones.setBitOn(start);
+	auto& accessible = layers[GermanAccessible];
+	return zones.reach(moves, accessible) & accessible;
 }
 
 // Is this zone within the given distance from some type of zone?
-//   Pass one of the isXZone() functions as last argument
+//   Uses precomputed layer if possible; else searches the area
 bool SearchBoard::isNearZoneType(const GridCoordinate& zone, int distance, 
-		bool (SearchBoard::*zoneType)(const GridCoordinate& zone) const) const 
+		Layers layer) const 
 {
 	assert(distance >= 0);
+	if (distance == 0) {
+		return layers[layer].isBitOn(zone);
+	}
+	if (distance <= MAX_NEAR_DISTANCE && zone.isOnBoard()) {
+		return nearLayers[layer][distance - 1].isBitOn(zone);
+	}
 	auto area = zone.getArea(distance);
 	for (auto zone: area) {
-		if ((this->*zoneType)(zone)) {
+		if (layers[layer].isBitOn(zone)) {
 			return true;			
 		}
 	}
@@ -96,8 +170,74 @@ bool SearchBoard::isNearZoneType(const GridCoordinate& zone, int distance,
 }
 
 // Is this zone within the area of the British patrol line?
-//   That is: In or east of white dots on the map (Rule 10.211)
+//   Precomputed for zones on board
 bool SearchBoard::isInsidePatrolLine(const GridCoordinate& zone) const {
+	return zone.isOnBoard() ? layers[InsidePatrol].isBitOn(zone)
+		: calcInsidePatrolLine(zone);
+}
+
+// Can German ships enter this zone?
+bool SearchBoard::isGermanAccessible(const GridCoordinate& zone) const {
+	return layers[GermanAccessible].isBitOn(zone);
+}
+
+// Get the applicable general search table column
+//   Precomputed for zones on board
+char SearchBoard::getGeneralSearchColumn(const GridCoordinate& zone) const {
+	return zone.isOnBoard() ? generalSearchColumn[zone.index()]
+		: calcGeneralSearchColumn(zone);
+}
+
+// Get moves by sea to nearest zone of a destination type
+//   Unreachable if none can be reached (or zone is off board)
+int SearchBoard::getSeaDistance(const GridCoordinate& zone, 
+	Destinations dest) const
+{
+	return zone.isOnBoard() ? destFields[dest].distance[zone.index()]
+		: SeaGraph::UNREACHABLE;
+}
+
+// Get nearest zone of a destination type by sea
+//   Off board if none can be reached (or zone is off board)
+GridCoordinate SearchBoard::getNearest(const GridCoordinate& zone, 
+	Destinations dest) const
+{
+	int nearest = zone.isOnBoard() ? destFields[dest].nearest[zone.index()]
+		: -1;
+	return nearest < 0 ? GridCoordinate::OFFBOARD 
+		: GridCoordinate::fromIndex(nearest);
+}
+
+// Get hazard of zone to German ships (-1 to MAX_HAZARD)
+//   Precomputed for zones on board
+int SearchBoard::getHazard(const GridCoordinate& zone) const {
+	return zone.isOnBoard() ? hazard[zone.index()] : calcHazard(zone);
+}
+
+// Calculate hazard of zone to German ships
+//   Patrol line & zones near the British coast are searched
+//   on better columns (Rule 10.214); fog may hide us (Rule 10.213)
+int SearchBoard::calcHazard(const GridCoordinate& zone) const {
+	int hazard = 0;
+	if (isBritishPatrolLine(zone)) {
+		hazard += 2;
+	}
+	if (isNearZoneType(zone, 1, BritishCoast)) {
+		hazard += 2;
+	}
+	else if (isNearZoneType(zone, 2, BritishCoast)) {
+		hazard += 1;
+	}
+	if (isFogZone(zone)) {
+		hazard -= 1;
+	}
+	assert(-1 <= hazard && hazard <= MAX_HAZARD);
+	return hazard;
+}
+
+// Calculate if zone is within the area of the British patrol line
+//   That is: In or east of white dots on the map (Rule 10.211)
+bool SearchBoard::calcInsidePatrolLine(const GridCoordinate& zone) const {
 	char row = zone.getRow();
 	int col = zone.getCol();
 	while (col > 0) {
@@ -118,3 +258,30 @@ std::vector<GridCoordinate> SearchBoard::getAllGermanPorts() const {
 std::vector<GridCoordinate> SearchBoard::getAllConvoyRoutes() const {
 	return layers[ConvoyRoutes].getAllOn();
 }
+
+// Calculate if German ships can enter this zone
+bool SearchBoard::calcGermanAccessible(const GridCoordinate& zone) const {
+	return isSeaZone(zone)           // Rule 5.17
+		&& !isIrishSea(zone)         // Rule 5.18
+		&& !isBritishPort(zone);     // Rule 5.18
+}
+
+// Calculate the applicable general search table column
+//   As per rule 10.214.
+char SearchBoard::calcGeneralSearchColumn(const GridCoordinate& zone) const {
+
+	// Case 'A': western edge, near patrol line limit
+	if (isNearZoneType(zone, 2, BritishPatrol)) {
+		return 'A';	
+	}
+
+	// Case 'C': eastern edge, near coast of Britain/Ireland
+	else if (isNearZoneType(zone, 2, BritishCoast)) {
+		return 'C';		
+	}
+
+	// Case 'B': in-between, any other location
+	else {
+		return 'B';	
+	}
+}
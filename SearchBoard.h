@@ -4,17 +4,39 @@
 	Author: Daniel R. Collins
 	Date: 23-11-24 21:25
 	Description: Class to represent the Bismarck Search Board.
-		Singleton class pattern.
+		Loaded once, then shared read-only by all games.
+		File layers are compiled in (see MakeBoardData),
+		or may be read from CSV files in a given directory.
+		Layers after those from files are derived at load time,
+		as are zones near each layer, general search columns,
+		and the graph of sea moves (with distances around land),
+		and sea distances to the nearest of some key destinations,
+		and the hazard of each zone to German ships (for routing).
 */
 #ifndef SEARCHBOARD_H
 #define SEARCHBOARD_H
 #include "GridCoordinate.h"
 #include "SearchBoardLayer.h"
+#include "SeaGraph.h"
+
+// Forwards
+class RandomStream;
 
 class SearchBoard
 {
 	public:
-		static SearchBoard* instance();
+		enum Layers {SeaZones, BritishCoast, BritishPorts, GermanPorts,
+			FogZones, IrishSea, BritishPatrol, ConvoyRoutes, 
+			InsidePatrol, GermanAccessible, NUM_LAYERS};
+		static const int NUM_FILE_LAYERS = ConvoyRoutes + 1;
+		enum Destinations {ToConvoyRoutes, ToGermanPorts, ToRowZ, 
+			NUM_DESTINATIONS};
+		static const int MAX_HAZARD = 4;
+		SearchBoard();
+		SearchBoard(const std::string& csvDir);
+		const SearchBoardLayer& getLayer(Layers layer) const 
+			{ return layers[layer]; }
+		const SeaGraph& getSeaGraph() const { return seaGraph; }
 		bool isSeaZone(const GridCoordinate& zone) const;
 		bool isBritishCoast(const GridCoordinate& zone) const;
 		bool isBritishPort(const GridCoordinate& zone) const;
@@ -24,30 +46,52 @@ class SearchBoard
 		bool isBritishPatrolLine(const GridCoordinate& zone) const;
 		bool isConvoyRoute(const GridCoordinate& zone) const;
 		bool isNearZoneType(const GridCoordinate& zone, 
-			int distance, bool (SearchBoard::*zoneType)
-				(const GridCoordinate& zone) const) const;
+			int distance, Layers layer) const;
 		bool isInsidePatrolLine(const GridCoordinate& zone) const;
+		bool isGermanAccessible(const GridCoordinate& zone) const;
+		char getGeneralSearchColumn(const GridCoordinate& zone) const;
+		int getSeaDistance(const GridCoordinate& zone, 
+			Destinations dest) const;
+		GridCoordinate getNearest(const GridCoordinate& zone, 
+			Destinations dest) const;
+		int getHazard(const GridCoordinate& zone) const;
+		int getHazard(int zoneIdx) const { return hazard[zoneIdx]; }
 		GridCoordinate randSeaZone(const GridCoordinate& center, 
-			int radius) const;
+			int radius, RandomStream& random) const;
+		SearchBoardLayer getReach(const GridCoordinate& start, 
+			int moves) const;
 		std::vector<GridCoordinate> getAllGermanPorts() const;
 		std::vector<GridCoordinate> getAllConvoyRoutes() const;
 		void print() const;
 
 	private:
-		SearchBoard();
-		static SearchBoard* theInstance;
-		enum Layers {SeaZones, BritishCoast, BritishPorts, GermanPorts,
-			FogZones, IrishSea, BritishPatrol, ConvoyRoutes, NUM_LAYERS};
-		SearchBoardLayer layers[NUM_LAYERS] = {
-			SearchBoardLayer("SearchBoard-SeaZones.csv"),
-			SearchBoardLayer("SearchBoard-BritishCoast.csv"),
-			SearchBoardLayer("SearchBoard-BritishPorts.csv"),
-			SearchBoardLayer("SearchBoard-GermanPorts.csv"),
-			SearchBoardLayer("SearchBoard-FogZones.csv"),
-			SearchBoardLayer("SearchBoard-IrishSea.csv"),
-			SearchBoardLayer("SearchBoard-BritishPatrol.csv"),
-			SearchBoardLayer("SearchBoard-ConvoyRoutes.csv")
-		};
+		static const int MAX_NEAR_DISTANCE = 3;
+		static const char* const FILE_LAYER_NAMES[NUM_FILE_LAYERS];
+		SearchBoardLayer layers[NUM_LAYERS];
+
+		// Layers dilated to zones within distance 1 to max
+		SearchBoardLayer nearLayers[NUM_LAYERS][MAX_NEAR_DISTANCE];
+
+		// General search column for each zone
+		char generalSearchColumn[GridCoordinate::NUM_ZONES];
+
+		// Moves between zones accessible to German ships
+		SeaGraph seaGraph;
+
+		// Sea distances to nearest zone of each destination type
+		SeaGraph::DistanceField destFields[NUM_DESTINATIONS];
+
+		// Hazard of each zone to German ships
+		int8_t hazard[GridCoordinate::NUM_ZONES];
+
+		// Derived data functions
+		void deriveAll();
+		void deriveLayer(Layers layer, const char* name,
+			std::function<bool(const GridCoordinate&)> rule);
+		bool calcInsidePatrolLine(const GridCoordinate& zone) const;
+		bool calcGermanAccessible(const GridCoordinate& zone) const;
+		char calcGeneralSearchColumn(const GridCoordinate& zone) const;
+		int calcHazard(const GridCoordinate& zone) const;
 };
 
 #endif
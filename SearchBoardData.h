@@ -0,0 +1,82 @@
+/*
+	Name: SearchBoardData
+	Description: Search Board layers as row bitmasks,
+		compiled from SearchBoard-*.csv files (bit 0 = column 1).
+		Generated by MakeBoardData; do not edit by hand.
+*/
+#ifndef SEARCHBOARDDATA_H
+#define SEARCHBOARDDATA_H
+#include <cstdint>
+
+namespace SearchBoardData {
+
+constexpr uint32_t LAYER_ROWS[8][26] = {
+	// SeaZones
+	{
+		0x0003ff80, 0x0003ffc0, 0x0007fc70, 0x0003f8f8, 0x0007fdfc, 0x000ffffe,
+		0x001fffff, 0x003fffff, 0x003dfffe, 0x007bfffe, 0x0067fffc, 0x00c9fffc,
+		0x000bfff8, 0x001bfff8, 0x003ffff0, 0x007ffff0, 0x01ffffe0, 0x03ffffe0,
+		0x03ffffc0, 0x03ffffc0, 0x007fff80, 0x00ffff80, 0x00ffff00, 0x01ffff00,
+		0x03fffe00, 0x1ffffe00
+	},
+	// BritishCoast
+	{
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00020000, 0x00030000, 0x00050000, 0x000f0000, 0x003e0000, 0x007a0000,
+		0x009a0000, 0x00fc0000, 0x00300000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000
+	},
+	// BritishPorts
+	{
+		0x00000000, 0x00000000, 0x00000000, 0x00000100, 0x00000000, 0x00000000,
+		0x00000000, 0x00020000, 0x00000000, 0x00040000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00200000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x10000000
+	},
+	// GermanPorts
+	{
+		0x00000000, 0x00000000, 0x00040000, 0x00000000, 0x00000000, 0x00080000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00400000, 0x01000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000
+	},
+	// FogZones
+	{
+		0x00000380, 0x000007c0, 0x00000460, 0x00000000, 0x00000000, 0x00080000,
+		0x00100000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000
+	},
+	// IrishSea
+	{
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00040000, 0x00080000,
+		0x00080000, 0x00100000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00000000
+	},
+	// BritishPatrol
+	{
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000004, 0x00000008,
+		0x00000010, 0x00000020, 0x00000040, 0x00000080, 0x00000700, 0x00000800,
+		0x00001000, 0x00002000, 0x00004000, 0x00008000, 0x00010000, 0x00020000,
+		0x00040000, 0x00080000, 0x00100000, 0x00200000, 0x00200000, 0x00200000,
+		0x00200000, 0x00200000
+	},
+	// ConvoyRoutes
+	{
+		0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+		0x00000000, 0x00003fff, 0x00004000, 0x0001c000, 0x00064000, 0x00004000,
+		0x00004000, 0x00004000, 0x00004000, 0x00004000, 0x00008000, 0x00008000,
+		0x00010000, 0x00010000, 0x00020000, 0x00020000, 0x00040000, 0x00040000,
+		0x00080000, 0x00080000
+	}
+};
+
+}
+
+#endif
@@ -1,18 +1,28 @@
 #include "SearchBoardLayer.h"
 #include "CSVReader.h"
 #include "Utils.h"
+#include "RandomStream.h"
 #include <iostream>
 #include <cassert>
 using namespace std;
 
+// Default constructor (no bits on)
+SearchBoardLayer::SearchBoardLayer() {
+}
+
 // Constructor from CSV file data
 //   Expects data file stored as transpose of printed board
 //   Therefore, coordinates match between board & spreadsheet app.
-SearchBoardLayer::SearchBoardLayer(const std::string &filename) {
+SearchBoardLayer::SearchBoardLayer(const char* name, 
+	const std::string &filename)
+{
 	assert(sizeof(rowData[0]) == 4);
 	assert(MAX_COL <= sizeof(rowData[0]) * 8);
-	this->filename = filename;
+	this->name = name;
 	vector<vector<string>> fileData = CSVReader::readFile(filename);
+	if (fileData.size() != MAX_COL) {
+		cerr << "Error: Bad search board file " << filename << endl;
+	}
 	assert(fileData.size() == MAX_COL);
 	for (int col = MIN_COL; col <= MAX_COL; col++) {
 		int colIdx = col - MIN_COL;
@@ -26,6 +36,30 @@ SearchBoardLayer::SearchBoardLayer(const std::string &filename) {
 	}
 }
 
+// Constructor from row bitmasks
+//   For data compiled into the program
+SearchBoardLayer::SearchBoardLayer(const char* name, const uint32_t rows[]) {
+	this->name = name;
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		rowData[rowIdx] = rows[rowIdx];
+	}
+}
+
+// Constructor from a rule for each zone
+//   For layers derived from others
+SearchBoardLayer::SearchBoardLayer(const char* name,
+	std::function<bool(const GridCoordinate&)> rule)
+{
+	this->name = name;
+	for (char row = MIN_ROW; row <= MAX_ROW; row++) {
+		for (int col = MIN_COL; col <= MAX_COL; col++) {
+			if (rule(GridCoordinate(row, col))) {
+				rowData[row - MIN_ROW] |= (1 << (col - MIN_COL));
+			}
+		}
+	}
+}
+
 // Check if a given bit is on
 //   Convert from board coordinate values to data indeces
 //   Return false for any locations outside data store ranges
@@ -42,11 +76,174 @@ bool SearchBoardLayer::isBitOn(GridCoordinate coord) const {
 	return false;
 }
 
+// Set a given bit on
+//   Ignored for any locations outside data store ranges
+void SearchBoardLayer::setBitOn(GridCoordinate coord) {
+	char row = coord.getRow();
+	int col = coord.getCol();	
+	if (isInInterval(MIN_ROW, row, MAX_ROW)
+		&& isInInterval(MIN_COL, col, MAX_COL))
+	{
+		rowData[row - MIN_ROW] |= (1 << (col - MIN_COL));
+	}
+}
+
+// Are all bits off?
+bool SearchBoardLayer::isEmpty() const {
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		if (rowData[rowIdx]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Count the bits on
+int SearchBoardLayer::countOn() const {
+	int count = 0;
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		count += __builtin_popcount(rowData[rowIdx]);
+	}
+	return count;
+}
+
+// Get the nth zone with bit on (from 0, in row order)
+GridCoordinate SearchBoardLayer::getNthOn(int n) const {
+	assert(0 <= n && n < countOn());
+	int rowIdx = 0;
+	int rowCount = __builtin_popcount(rowData[rowIdx]);
+	while (n >= rowCount) {
+		n -= rowCount;
+		rowCount = __builtin_popcount(rowData[++rowIdx]);
+	}
+	uint32 bits = rowData[rowIdx];
+	for (int i = 0; i < n; i++) {
+		bits &= bits - 1; // clear lowest bit
+	}
+	int colIdx = __builtin_ctz(bits);
+	return GridCoordinate(MIN_ROW + rowIdx, MIN_COL + colIdx);
+}
+
+// Get a random zone with bit on (must be some)
+GridCoordinate SearchBoardLayer::randZoneOn(RandomStream& random) const {
+	assert(!isEmpty());
+	return getNthOn(random.rand(countOn()));
+}
+
+// Get layer with bits on for all zones within 1 of this one
+//   Hex neighbors of (row, col) are: (row, col +/- 1),
+//   (row - 1, col - 1), (row - 1, col), (row + 1, col), (row + 1, col + 1)
+SearchBoardLayer SearchBoardLayer::dilate() const {
+	SearchBoardLayer result;
+	result.name = name;
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		uint32 mask = rowData[rowIdx];
+		uint32 bits = mask | mask << 1 | mask >> 1;
+		if (rowIdx > 0) {
+			uint32 above = rowData[rowIdx - 1];
+			bits |= above | above << 1;
+		}
+		if (rowIdx < NUM_ROWS - 1) {
+			uint32 below = rowData[rowIdx + 1];
+			bits |= below | below >> 1;
+		}
+		result.rowData[rowIdx] = bits & ROW_MASK;
+	}
+	return result;
+}
+
+// Get layer dilated only into passable zones
+//   (i.e., one move onward; zones here stay on)
+SearchBoardLayer SearchBoardLayer::dilate(
+	const SearchBoardLayer& passable) const 
+{
+	return (dilate() & passable) | *this;
+}
+
+// Get layer with bits on for all zones reachable from this one
+//   in given moves or less, moving only through passable zones
+SearchBoardLayer SearchBoardLayer::reach(int moves, 
+	const SearchBoardLayer& passable) const 
+{
+	SearchBoardLayer result = *this;
+	for (int i = 0; i < moves; i++) {
+		SearchBoardLayer next = result.dilate(passable);
+		if (next == result) {
+			break;
+		}
+		result = next;
+	}
+	return result;
+}
+
+// Find rings of zones by moves from this layer, through passable zones
+//   Ring 0 is this layer; ring n holds zones first reached in n moves.
+//   Ends with the last ring not empty (ones never reached are in none).
+std::vector<SearchBoardLayer> SearchBoardLayer::findRings(
+	const SearchBoardLayer& passable) const 
+{
+	std::vector<SearchBoardLayer> rings;
+	SearchBoardLayer reached = *this;
+	SearchBoardLayer frontier = *this;
+	while (!frontier.isEmpty()) {
+		rings.push_back(frontier);
+		frontier = (frontier.dilate() & passable) - reached;
+		reached = reached | frontier;
+	}
+	return rings;
+}
+
+// Intersection of layers
+SearchBoardLayer SearchBoardLayer::operator&(
+	const SearchBoardLayer& other) const 
+{
+	SearchBoardLayer result;
+	result.name = name;
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		result.rowData[rowIdx] = rowData[rowIdx] & other.rowData[rowIdx];
+	}
+	return result;
+}
+
+// Union of layers
+SearchBoardLayer SearchBoardLayer::operator|(
+	const SearchBoardLayer& other) const 
+{
+	SearchBoardLayer result;
+	result.name = name;
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		result.rowData[rowIdx] = rowData[rowIdx] | other.rowData[rowIdx];
+	}
+	return result;
+}
+
+// Difference of layers (bits on here but not in other)
+SearchBoardLayer SearchBoardLayer::operator-(
+	const SearchBoardLayer& other) const 
+{
+	SearchBoardLayer result;
+	result.name = name;
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		result.rowData[rowIdx] = rowData[rowIdx] & ~other.rowData[rowIdx];
+	}
+	return result;
+}
+
+// Do layers have the same bits on? (name not compared)
+bool SearchBoardLayer::operator==(const SearchBoardLayer& other) const {
+	for (int rowIdx = 0; rowIdx < NUM_ROWS; rowIdx++) {
+		if (rowData[rowIdx] != other.rowData[rowIdx]) {
+			return false;
+		}
+	}
+	return true;
+}
+
 // Print the layer (for testing)
 //   Note the printed board has hidden negative columns in top-left;
 //   so we handle that with distinct column start print value.
 void SearchBoardLayer::print() const {
-	cout << filename << endl;
+	cout << name << endl;
 	for (char row = MIN_ROW; row <= MAX_ROW; row++) {
 		
 		// Account for column shearing
@@ -6,27 +6,59 @@
 	Description: Provides one layer of binary information
 		for the Search Board (e.g., sea, coast, etc.).
 		Indexes are 1-based (to match printed game board).
+		Stored as a bitmask per row (bit 0 = column 1).
+		Name should be a string literal (not copied).
+		Set operations & moves work a whole row at a time
+		(e.g., zones reachable within some moves, by sea):
+		a breadth-first search is a few dozen such steps.
 */
 #ifndef SEARCHBOARDLAYER_H
 #define SEARCHBOARDLAYER_H
 #include "GridCoordinate.h"
 #include <string>
 #include <vector>
+#include <functional>
+#include <cstdint>
+
+// Forwards
+class RandomStream;
 
 // Search Board Layer class
 class SearchBoardLayer
 {
 	public:
-		SearchBoardLayer(const std::string &filename);
+		SearchBoardLayer();
+		SearchBoardLayer(const char* name, const std::string &filename);
+		SearchBoardLayer(const char* name, const uint32_t rows[]);
+		SearchBoardLayer(const char* name,
+			std::function<bool(const GridCoordinate&)> rule);
+		const char* getName() const { return name; }
 		bool isBitOn(GridCoordinate coord) const;
+		void setBitOn(GridCoordinate coord);
+		bool isEmpty() const;
+		int countOn() const;
+		GridCoordinate getNthOn(int n) const;
+		GridCoordinate randZoneOn(RandomStream& random) const;
+		SearchBoardLayer dilate() const;
+		SearchBoardLayer dilate(const SearchBoardLayer& passable) const;
+		SearchBoardLayer reach(int moves, 
+			const SearchBoardLayer& passable) const;
+		std::vector<SearchBoardLayer> findRings(
+			const SearchBoardLayer& passable) const;
 		std::vector<GridCoordinate> getAllOn() const;
 		void print() const;
 
+		// Set operations (name from left side)
+		SearchBoardLayer operator&(const SearchBoardLayer& other) const;
+		SearchBoardLayer operator|(const SearchBoardLayer& other) const;
+		SearchBoardLayer operator-(const SearchBoardLayer& other) const;
+		bool operator==(const SearchBoardLayer& other) const;
+
 	private:
 		
 		// Data
-		std::string filename;
-		typedef unsigned int uint32;
+		const char* name = "";
+		typedef uint32_t uint32;
 		static const char MIN_ROW = 'A';
 		static const char MAX_ROW = 'Z';
 		static const int MIN_COL = 1;
@@ -34,6 +66,7 @@ class SearchBoardLayer
 		static const int MIN_PRINT_COL = -2;
 		static const int MAX_PRINT_COL = 32;
 		static const int NUM_ROWS = MAX_ROW - MIN_ROW + 1;
+		static const uint32 ROW_MASK = (1u << MAX_COL) - 1;
 		uint32 rowData[NUM_ROWS] = {0};
 };
 
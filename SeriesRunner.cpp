@@ -0,0 +1,308 @@
+#include "SeriesRunner.h"
+#include "GameContext.h"
+#include "CmdArgs.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <thread>
+using namespace std;
+
+// Constructor
+//   Number of threads zero or less means use all cores
+SeriesRunner::SeriesRunner(const SearchBoard& board, const CmdArgs& args,
+	int numGames, int numThreads): board(board), args(args),
+	compareArgs(args)
+{
+	if (numThreads <= 0) {
+		numThreads = thread::hardware_concurrency();
+	}
+	this->numGames = numGames;
+	this->numThreads = max(1, numThreads);
+	precision = args.getPrecision();
+	compareArgs.setStrategyVariant(args.getCompareVariant());
+}
+
+// Run the series of games
+//   Workers run for the whole series, claiming ranges of games.
+//   Each block's range tallies are merged in order once done;
+//   with a precision target, check it after each block.
+//   Random numbers are keyed by game number (not thread), and
+//   blocks & ranges by game number, so results are the same 
+//   for any number of threads.
+void SeriesRunner::run() {
+	Schedule schedule;
+	schedule.tallies.resize(AHEAD_BLOCKS * RANGES_PER_BLOCK);
+	int workerCount = min(numThreads, getNumRanges());
+	vector<thread> workers;
+	for (int i = 0; i < workerCount; i++) {
+		workers.emplace_back(&SeriesRunner::runWorker, this, 
+			ref(schedule));
+	}
+	int numBlocks = (numGames + CHECK_BLOCK_GAMES - 1) / CHECK_BLOCK_GAMES;
+	for (int block = 0; block < numBlocks; block++) {
+		unique_lock<mutex> lock(schedule.mutex);
+		int& rangesDone = schedule.rangesDone[block % AHEAD_BLOCKS];
+		int blockRanges = getNumRanges(block);
+		schedule.changed.wait(lock, 
+			[&] { return rangesDone == blockRanges; });
+		Tally* tally = &schedule.tallies[
+			block % AHEAD_BLOCKS * RANGES_PER_BLOCK];
+		for (int i = 0; i < blockRanges; i++) {
+			total.merge(tally[i]);
+			tally[i] = Tally();
+		}
+		rangesDone = 0;
+		schedule.blocksMerged++;
+		if (precision > 0 && isPrecisionMet()) {
+			schedule.stopped = true;
+		}
+		schedule.changed.notify_all();
+		if (schedule.stopped) {
+			break;
+		}
+	}
+	for (auto& worker: workers) {
+		worker.join();
+	}
+}
+
+// Get number of ranges of games in the series
+int SeriesRunner::getNumRanges() const {
+	return (numGames + RANGE_GAMES - 1) / RANGE_GAMES;
+}
+
+// Get number of ranges of games in one block
+int SeriesRunner::getNumRanges(int block) const {
+	return min((int) RANGES_PER_BLOCK, 
+		getNumRanges() - block * RANGES_PER_BLOCK);
+}
+
+// Run ranges of games on a worker thread until none left
+//   Waits before running ahead of unmerged blocks
+//   (so tallies held stay bounded), or quits if stopped.
+void SeriesRunner::runWorker(Schedule& schedule) const {
+	int numRanges = getNumRanges();
+	while (true) {
+		int range = schedule.nextRange++;
+		if (range >= numRanges) {
+			return;
+		}
+		int block = range / RANGES_PER_BLOCK;
+		{
+			unique_lock<mutex> lock(schedule.mutex);
+			schedule.changed.wait(lock, [&] { 
+				return schedule.stopped 
+					|| block < schedule.blocksMerged + AHEAD_BLOCKS; 
+			});
+			if (schedule.stopped) {
+				return;
+			}
+		}
+		int firstGame = range * RANGE_GAMES;
+		runGames(firstGame, min((int) RANGE_GAMES, numGames - firstGame),
+			schedule.tallies[range % (AHEAD_BLOCKS * RANGES_PER_BLOCK)]);
+		lock_guard<mutex> lock(schedule.mutex);
+		schedule.rangesDone[block % AHEAD_BLOCKS]++;
+		schedule.changed.notify_all();
+	}
+}
+
+// Run a block of games on the current thread
+//   If comparing, rerun each game index with the other variant:
+//   weather, chance & British rolls are on their own streams,
+//   so both see the same environment (common random numbers).
+void SeriesRunner::runGames(int firstGame, int numGames, 
+	Tally& tally) const
+{
+	for (int i = firstGame; i < firstGame + numGames; i++) {
+		GameContext context(board, args, i);
+		auto& game = context.getDirector();
+		game.doGameLoop();
+		tally.recordGame(game);
+		if (args.isCompareSeries()) {
+			GameContext compContext(board, compareArgs, i);
+			auto& compGame = compContext.getDirector();
+			compGame.doGameLoop();
+			tally.recordPair(game, compGame);
+		}
+	}
+}
+
+// Check if every confidence interval is within target precision
+bool SeriesRunner::isPrecisionMet() const {
+	if (total.gamesDetected.getWilsonHalfWidth() > precision
+		|| total.gamesConvoySunk.getWilsonHalfWidth() > precision
+		|| total.detections.getHalfWidth() > precision
+		|| total.convoysSunk.getHalfWidth() > precision
+		|| total.getRatioHalfWidth() > precision)
+	{
+		return false;
+	}
+	if (args.isCompareSeries()) {
+		for (auto& stat: total.paired) {
+			if (stat.diff.getHalfWidth() > precision) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Record statistics from one finished game
+//   Co-moment updated alongside the means (Welford-style),
+//   for the ratio's confidence interval
+void SeriesRunner::Tally::recordGame(const GameDirector& game) {
+	int timesDetected = game.getBismarck().getTimesDetected();
+	int convoys = game.getConvoysSunk();
+	gamesDetected.add(timesDetected > 0);
+	gamesConvoySunk.add(convoys > 0);
+	double deltaDetections = timesDetected - detections.getMean();
+	detections.add(timesDetected);
+	convoysSunk.add(convoys);
+	coMoment += deltaDetections * (convoys - convoysSunk.getMean());
+	if (convoys < NUM_SUNK_BINS) {
+		convoysSunkBin[convoys]++;
+	}
+}
+
+// Record statistics from a pair of games (base & compared variant)
+void SeriesRunner::Tally::recordPair(const GameDirector& base, 
+	const GameDirector& comp)
+{
+	int baseDetections = base.getBismarck().getTimesDetected();
+	int compDetections = comp.getBismarck().getTimesDetected();
+	paired[PAIR_GAMES_DETECTED].record(
+		baseDetections > 0, compDetections > 0);
+	paired[PAIR_DETECTIONS].record(baseDetections, compDetections);
+	paired[PAIR_CONVOYS_SUNK].record(
+		base.getConvoysSunk(), comp.getConvoysSunk());
+}
+
+// Record one paired observation
+void SeriesRunner::PairedStat::record(double baseValue, double compValue) {
+	base.add(baseValue);
+	comp.add(compValue);
+	diff.add(compValue - baseValue);
+}
+
+// Combine another paired statistic into this one
+void SeriesRunner::PairedStat::merge(const PairedStat& other) {
+	base.merge(other.base);
+	comp.merge(other.comp);
+	diff.merge(other.diff);
+}
+
+// Combine another tally into this one
+void SeriesRunner::Tally::merge(const Tally& other) {
+	long count = getNumGames(), otherCount = other.getNumGames();
+	if (count + otherCount > 0) {
+		double deltaDetections = other.detections.getMean() 
+			- detections.getMean();
+		double deltaConvoys = other.convoysSunk.getMean() 
+			- convoysSunk.getMean();
+		coMoment += other.coMoment + deltaDetections * deltaConvoys 
+			* count * otherCount / (count + otherCount);
+	}
+	gamesDetected.merge(other.gamesDetected);
+	gamesConvoySunk.merge(other.gamesConvoySunk);
+	detections.merge(other.detections);
+	convoysSunk.merge(other.convoysSunk);
+	for (int i = 0; i < NUM_SUNK_BINS; i++) {
+		convoysSunkBin[i] += other.convoysSunkBin[i];
+	}
+	for (int i = 0; i < NUM_PAIRED_STATS; i++) {
+		paired[i].merge(other.paired[i]);
+	}
+}
+
+// Get ratio of convoys sunk per detection
+double SeriesRunner::Tally::getRatio() const {
+	return convoysSunk.getMean() / detections.getMean();
+}
+
+// Get half-width of confidence interval for the ratio
+//   By the delta method: variance of (convoys - ratio * detections)
+double SeriesRunner::Tally::getRatioHalfWidth() const {
+	long count = getNumGames();
+	if (count < 2 || detections.getMean() == 0) {
+		return 1.0;
+	}
+	double ratio = getRatio();
+	double covariance = coMoment / (count - 1);
+	double variance = convoysSunk.getVariance() 
+		- 2 * ratio * covariance
+		+ ratio * ratio * detections.getVariance();
+	return RunningStat::Z_95 * sqrt(max(0.0, variance) / count)
+		/ detections.getMean();
+}
+
+// Print an estimate with its confidence interval
+void printEstimate(const char* name, double estimate, 
+	double low, double high)
+{
+	cout << name << ": " << estimate 
+		<< " [" << low << ", " << high << "]\n";
+}
+
+// Report statistics
+//   Proportions use Wilson intervals; means use normal intervals
+void SeriesRunner::report() const {
+	long count = total.getNumGames();
+	cout << "Random seed: " << args.getSeed() << "\n";
+	cout << "Games run: " << count << "\n";
+	cout << "Estimates with 95% confidence intervals:\n";
+	cout << fixed << showpoint << setprecision(3);
+	auto& detected = total.gamesDetected;
+	printEstimate("Games Bismarck detected", detected.getMean(),
+		detected.getWilsonLow(), detected.getWilsonHigh());
+	auto& convoySunk = total.gamesConvoySunk;
+	printEstimate("Games convoy sunk", convoySunk.getMean(),
+		convoySunk.getWilsonLow(), convoySunk.getWilsonHigh());
+	auto& detections = total.detections;
+	printEstimate("Mean Bismarck detections", detections.getMean(),
+		detections.getMean() - detections.getHalfWidth(),
+		detections.getMean() + detections.getHalfWidth());
+	auto& convoys = total.convoysSunk;
+	printEstimate("Mean convoys sunk", convoys.getMean(),
+		convoys.getMean() - convoys.getHalfWidth(),
+		convoys.getMean() + convoys.getHalfWidth());
+	double ratio = total.getRatio();
+	printEstimate("Convoys/detection ratio", ratio,
+		ratio - total.getRatioHalfWidth(),
+		ratio + total.getRatioHalfWidth());
+
+	// Report convoys sunk bins
+	cout << "Convoys sunk relative frequencies:\n  ";
+	for (int i = 0; i < NUM_SUNK_BINS; i++) {
+		int percent = (int)((float) total.convoysSunkBin[i] / count * 100);
+		if (percent > 0) {
+			cout << (i ? ", " : "") << i << ":" << percent << "%";
+		}
+	}
+	cout << "\n";
+	if (args.isCompareSeries()) {
+		reportPaired();
+	}
+}
+
+// Report paired differences between variants
+//   Unpaired standard error shown for reference
+//   (what independent samples of each variant would give)
+void SeriesRunner::reportPaired() const {
+	const char* names[NUM_PAIRED_STATS] = {
+		"Games Bismarck detected", 
+		"Mean Bismarck detections", 
+		"Mean convoys sunk"};
+	cout << "Paired differences (variant " << args.getCompareVariant() 
+		<< " - variant " << args.getStrategyVariant() << "):\n";
+	for (int i = 0; i < NUM_PAIRED_STATS; i++) {
+		auto& stat = total.paired[i];
+		double unpairedError = sqrt(
+			pow(stat.base.getStdError(), 2)
+			+ pow(stat.comp.getStdError(), 2));
+		cout << "  " << names[i] << ": " 
+			<< showpos << stat.diff.getMean() << noshowpos
+			<< " +/- " << stat.diff.getStdError()
+			<< " (unpaired +/- " << unpairedError << ")\n";
+	}
+}
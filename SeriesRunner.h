@@ -0,0 +1,104 @@
+/*
+	Name: SeriesRunner
+	Copyright: 2026
+	Author: Daniel R. Collins
+	Date: 16-10-26 14:20
+	Description: Runs a large series of automated games & reports stats.
+		Games may be split among several worker threads, which
+		claim ranges of games as they go; each range keeps its
+		own tally, merged in order of game number.
+		May also replay each game with a second German variant
+		(same random numbers otherwise) and report paired differences.
+		Given a precision target, runs in blocks of games and
+		stops once every confidence interval is narrow enough.
+*/
+#ifndef SERIESRUNNER_H
+#define SERIESRUNNER_H
+#include "CmdArgs.h"
+#include "RunningStat.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// Forwards
+class GameDirector;
+class SearchBoard;
+
+class SeriesRunner
+{
+	public:
+		SeriesRunner(const SearchBoard& board, const CmdArgs& args,
+			int numGames, int numThreads);
+		void run();
+		void report() const;
+
+	private:
+		// Constants
+		static const int NUM_SUNK_BINS = 7;
+		static const int CHECK_BLOCK_GAMES = 1000;
+		static const int RANGE_GAMES = 10;
+		static const int RANGES_PER_BLOCK = CHECK_BLOCK_GAMES / RANGE_GAMES;
+		static const int AHEAD_BLOCKS = 2;
+
+		// Statistics compared between variants
+		enum PairedStatId {PAIR_GAMES_DETECTED, PAIR_DETECTIONS, 
+			PAIR_CONVOYS_SUNK, NUM_PAIRED_STATS};
+
+		// One statistic over paired games
+		struct PairedStat {
+			RunningStat base, comp, diff;
+			void record(double baseValue, double compValue);
+			void merge(const PairedStat& other);
+		};
+
+		// Statistics tally structure
+		struct Tally {
+			RunningStat gamesDetected;
+			RunningStat gamesConvoySunk;
+			RunningStat detections;
+			RunningStat convoysSunk;
+			double coMoment = 0.0; // detections by convoys sunk
+			int convoysSunkBin[NUM_SUNK_BINS] = {0};
+			PairedStat paired[NUM_PAIRED_STATS];
+			void recordGame(const GameDirector& game);
+			void recordPair(const GameDirector& base, 
+				const GameDirector& comp);
+			void merge(const Tally& other);
+			long getNumGames() const { return detections.getCount(); }
+			double getRatio() const;
+			double getRatioHalfWidth() const;
+		};
+
+		// Schedule shared by workers
+		//   Ranges are claimed in order; tallies held for blocks
+		//   not yet merged (ahead limit), indexed by range.
+		struct Schedule {
+			std::atomic<int> nextRange{0};
+			std::mutex mutex;
+			std::condition_variable changed;
+			int blocksMerged = 0;
+			bool stopped = false;
+			int rangesDone[AHEAD_BLOCKS] = {0};
+			std::vector<Tally> tallies;
+		};
+
+		// Data
+		const SearchBoard& board;
+		const CmdArgs& args;
+		CmdArgs compareArgs;
+		int numGames;
+		int numThreads;
+		double precision;
+		Tally total;
+
+		// Functions
+		int getNumRanges() const;
+		int getNumRanges(int block) const;
+		void runWorker(Schedule& schedule) const;
+		void runGames(int firstGame, int numGames, Tally& tally) const;
+		bool isPrecisionMet() const;
+		void reportPaired() const;
+};
+
+#endif
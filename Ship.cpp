@@ -1,16 +1,18 @@
 #include "Ship.h"
 #include "Utils.h"
-#include "GameDirector.h"
+#include "GameContext.h"
 #include "SearchBoard.h"
 #include "GermanPlayer.h"
 #include "Navigator.h"
 #include "CmdArgs.h"
 #include <cassert>
+#include <cstring>
+#include <sstream>
 using namespace std;
 
 // Stream insertion operator
 std::ostream& operator<<(std::ostream& stream, const Ship& ship) {
-	stream << ship.getFullDesc();
+	ship.printFullDesc(stream);
 	return stream;
 }
 
@@ -25,27 +27,24 @@ const char* Ship::generalTypeName[]
 
 // Constructor
 //   DriveDefense indicates evasion loss rate (Rule 9.72)
-Ship::Ship(std::string name, Type type, 
+Ship::Ship(GameContext& context,
+	std::string name, Type type, 
 	int evasion, int midships, int fuel, 
 	GridCoordinate position,
 	GermanPlayer* player)
 {
+	this->context = &context;
 	this->name = name;
+	this->hashId = GameHash::nameId(name);
 	this->type = type;
 	this->evasionMax = evasion;
 	this->midshipsMax = midships;
 	this->fuelMax = fuel;
-	this->position = position;
 	this->player = player;
-	fuelLost = 0;
-	midshipsLost = 0;
-	evasionLostTemp = 0;
-	evasionLostPerm = 0;
-	timesDetected = 0;
-	onPatrol = false;
-	returnToBase = false;
+	state.position = position;
 	taskForce = nullptr;
 	setEvasionLossRate();
+	updateSpeedClass();
 }
 
 // Get our size
@@ -89,15 +88,23 @@ string Ship::getNameDesc() const {
 
 // Get a description with full information
 string Ship::getFullDesc() const {
-	return name
-		+ " (" + typeAbbr[type]
-		+ ", evrtg " + to_string(getEvasion())
-		+ ", mships " + to_string(getMidships())
-		+ ", fuel " + to_string(getFuel())
-		+ ", zone " + position.toString()
-		+ (onPatrol ? ", patrol" : "")
-		+ (returnToBase ? ", RTB" : "")
-		+ ")";
+	ostringstream stream;
+	printFullDesc(stream);
+	return stream.str();
+}
+
+// Print a description with full information
+//   (straight to stream, so logging builds no strings)
+void Ship::printFullDesc(std::ostream& stream) const {
+	stream << name
+		<< " (" << typeAbbr[type]
+		<< ", evrtg " << getEvasion()
+		<< ", mships " << getMidships()
+		<< ", fuel " << getFuel()
+		<< ", zone " << state.position
+		<< (state.onPatrol ? ", patrol" : "")
+		<< (state.returnToBase ? ", RTB" : "")
+		<< ")";
 }
 
 // Get the type of ship
@@ -118,17 +125,17 @@ Ship::GeneralType Ship::getGeneralType() const {
 
 // Get the current fuel
 int Ship::getFuel() const {
-	return max(0, fuelMax - fuelLost);
+	return max(0, fuelMax - state.fuelLost);
 }
 
 // Get the current midships
 int Ship::getMidships() const {
-	return max(0, midshipsMax - midshipsLost);
+	return max(0, midshipsMax - state.midshipsLost);
 }
 
 // Get the current evasion
 int Ship::getEvasion() const {
-	return max(0, evasionMax - evasionLostTemp - evasionLostPerm);
+	return max(0, evasionMax - state.evasionLostTemp - state.evasionLostPerm);
 }
 
 // Get evasion for launching an attack
@@ -138,24 +145,35 @@ int Ship::getAttackEvasion() const {
 
 // Take expense to our fuel
 void Ship::loseFuel(int loss) {
-	fuelLost += loss;	
+	rehash(GameHash::SHIP_FUEL_LOST, state.fuelLost, state.fuelLost + loss);
+	state.fuelLost += loss;	
+	markCacheStale();
 }
 
 // Take damage to our evasion rating (permanently)
 void Ship::loseEvasion(int loss) {
-	evasionLostPerm += loss;
+	rehash(GameHash::SHIP_EVASION_LOST_PERM, state.evasionLostPerm,
+		state.evasionLostPerm + loss);
+	state.evasionLostPerm += loss;
+	updateSpeedClass();
 }
 
 // Take damage to our midships
 void Ship::loseMidships(int loss) {
-	midshipsLost += loss;
+	rehash(GameHash::SHIP_MIDSHIPS_LOST, state.midshipsLost,
+		state.midshipsLost + loss);
+	state.midshipsLost += loss;
 	applyTempEvasionLoss(loss);
 	checkFuelDamage(loss);
 }
 
 // Apply temporary evasion loss from midships hit (Rule 9.72)
 void Ship::applyTempEvasionLoss(int midshipsLoss) {
-	evasionLostTemp += midshipsLoss * evasionLossRate;
+	int loss = midshipsLoss * evasionLossRate;
+	rehash(GameHash::SHIP_EVASION_LOST_TEMP, state.evasionLostTemp,
+		state.evasionLostTemp + loss);
+	state.evasionLostTemp += loss;
+	updateSpeedClass();
 }
 
 // Set how much evasion we lose per midships hit
@@ -185,28 +203,40 @@ void Ship::setEvasionLossRate() {
 
 // Try to repair evasion after movement (Rule 9.728)
 void Ship::tryEvasionRepair() {
-	if (evasionLostTemp && getSpeedThisTurn() <= 1) {
-		int repair = dieRoll(6) * 2 - 4;
+	if (state.evasionLostTemp && getSpeedThisTurn() <= 1) {
+		auto& random = context->getRandom(GameContext::CHANCE);
+		int repair = random.dieRoll(6) * 2 - 4;
 		repair = max(0, repair);
-		repair = min(repair, evasionLostTemp);
+		repair = min(repair, state.evasionLostTemp);
 		if (repair) {
 			clog << name << " repairs " 
 				<< repair << " evasion factor(s).\n";
-			evasionLostTemp -= repair;
-			assert(evasionLostTemp >= 0);			
+			rehash(GameHash::SHIP_EVASION_LOST_TEMP, state.evasionLostTemp,
+				state.evasionLostTemp - repair);
+			state.evasionLostTemp -= repair;
+			assert(state.evasionLostTemp >= 0);			
+			updateSpeedClass();
 		}
 	}
 }
 
 // Get our current search strength
-//   Note this is inferred for available German ship types
 int Ship::getSearchStrength() const {
+	if (turnCache.stale) {
+		fillTurnCache();
+	}
+	return turnCache.searchStrength;
+}
+
+// Compute our current search strength
+//   Note this is inferred for available German ship types
+int Ship::calcSearchStrength() const {
 	switch (type) {
 		case BB: case BC: 
-		case CA: return onPatrol ? (isInDay() ? 4 : 3) : 1;
-		case CL: return onPatrol ? (isInDay() ? 4 : 2) : 1;
-		case PB: return onPatrol ? (isInDay() ? 3 : 2) : 1;
-		case UB: return onPatrol ? 4 : (isInDay() ? 3 : 2);
+		case CA: return state.onPatrol ? (isInDay() ? 4 : 3) : 1;
+		case CL: return state.onPatrol ? (isInDay() ? 4 : 2) : 1;
+		case PB: return state.onPatrol ? (isInDay() ? 3 : 2) : 1;
+		case UB: return state.onPatrol ? 4 : (isInDay() ? 3 : 2);
 		case CV: case CT: return 1; // no patrol (Rules 5.31, 23.17)
 		default:
 			cerr << "Error: Unhandled ship type in search\n";
@@ -217,23 +247,48 @@ int Ship::getSearchStrength() const {
 
 // Set new position
 void Ship::setPosition(const GridCoordinate& zone) {
-	assert(log.empty());
-	position = zone;
+	assert(!state.turnsLogged);
+	rehash(GameHash::SHIP_ZONE, state.position.index(), zone.index());
+	state.position = zone;
+	markCacheStale();
 }
 
 // Get current position
 GridCoordinate Ship::getPosition() const {
-	return position;	
+	return state.position;	
 }
 
 // Are we on patrol?
 bool Ship::isOnPatrol() const {
-	return onPatrol;	
+	return state.onPatrol;	
 }
 
 // Do setup in first phase of turn
+//   (the new log record replaces the oldest we keep)
 void Ship::doAvailability() {
-	log.push_back(LogTurn());
+	state.turnsLogged++;
+	if (state.turnsLogged > LOG_TURNS) {
+		updateHash(calcLogHash(state.turnsLogged - LOG_TURNS));
+	}
+	logNow() = LogTurn();
+	markCacheStale();
+	fillTurnCache();
+}
+
+// Compute derived values for this turn (see TurnCache)
+void Ship::fillTurnCache() const {
+	turnCache.maxSpeedThisTurn = calcMaxSpeedThisTurn();
+	turnCache.searchStrength = calcSearchStrength();
+	turnCache.stale = false;
+}
+
+// Note a change to values we derive from
+//   (also stales our task force's aggregates)
+void Ship::markCacheStale() {
+	turnCache.stale = true;
+	if (taskForce) {
+		taskForce->markAggregatesStale();
+	}
 }
 
 // Do ordered movement for turn
@@ -242,10 +297,10 @@ void Ship::doMovementTurn() {
 	assert(hasOrders());
 
 	// Obey first order
-	onPatrol = false;
-	switch (orders.front().type) {
+	setOnPatrol(false);
+	switch (state.orders.front().type) {
 		case MOVE: doMoveOrder(); break;
-		case PATROL: onPatrol = true; break;
+		case PATROL: setOnPatrol(true); break;
 		case STOP: break;
 	}
 	
@@ -256,16 +311,30 @@ void Ship::doMovementTurn() {
 // Follow the leader of our task force
 void Ship::followShip(Ship& flagship) {
 	assert(isInTaskForce());
-	position = flagship.position;
-	onPatrol = flagship.onPatrol;
-	logNow().moves = flagship.logNow().moves;
+	rehash(GameHash::SHIP_ZONE, state.position.index(),
+		flagship.state.position.index());
+	state.position = flagship.state.position;
+	setOnPatrol(flagship.state.onPatrol);
+	int numMoves = logNow().numMoves;
+	logNow().copyMoves(flagship.logNow());
+	rehashLogMoves(numMoves);
 	assert(getSpeedThisTurn() <= getMaxSpeedThisTurn());
 	doPostMoveAccounts();
 }
 
+// Set or clear our patrol status
+void Ship::setOnPatrol(bool onPatrol) {
+	rehash(GameHash::SHIP_ON_PATROL, state.onPatrol, onPatrol);
+	state.onPatrol = onPatrol;
+	markCacheStale();
+}
+
 // Perform post-move accounting (fuel & repairs)
 void Ship::doPostMoveAccounts() {
-	int speed = logNow().moves.size();
+	int speed = logNow().numMoves;
+	if (context->getArgs().isTraceMoves()) {
+		traceMoves();
+	}
 	loseFuel(getFuelExpense(speed));
 	checkFuelForWeather(speed);
 	tryEvasionRepair();
@@ -273,14 +342,50 @@ void Ship::doPostMoveAccounts() {
 
 // Perform orders to move on search board
 void Ship::doMoveOrder() {
-	assert(orders.front().type == MOVE);
+	assert(state.orders.front().type == MOVE);
 
 	// Plot new route if needed
-	if (route.empty()) {
-		plotRoute(orders.front().zone);
+	//   (or if timed route is off schedule, or fog has changed)
+	if (state.route.empty() || !isOnTimedSchedule()) {
+		plotRoute(state.orders.front());
 	}
 
 	// Select speed to move
+	//   On timed route, moves as planned for this turn
+	//   (if we can't, we're off schedule: replot next turn)
+	int speed = getMoveSpeedThisTurn();
+	bool offSchedule = false;
+	if (!state.turnMoves.empty()) {
+		int planned = state.turnMoves.back();
+		state.turnMoves.pop_back();
+		state.timedRouteTurn++;
+		offSchedule = speed < planned;
+		speed = min(speed, planned);
+	}
+	
+	// Try to perform movement
+	for (int step = 0; step < speed; step++) {
+		if (!state.route.empty()) {
+			auto next = state.route.back();
+			state.route.pop_back();
+			assert(isAdjacent(next));
+			rehash(GameHash::SHIP_ZONE, state.position.index(), next.index());
+			state.position = next;
+			markCacheStale();
+			logNow().addMove(state.position);
+			rehashLogMoves(logNow().numMoves - 1);
+			updateOrders();
+		}
+	}
+	if (offSchedule) {
+		state.route.clear();
+		state.turnMoves.clear();
+	}
+}
+
+// How many board spaces will we move this turn?
+//   Max speed, but avoid emptying fuel, & lead task force at its speed
+int Ship::getMoveSpeedThisTurn() const {
 	int speed = getMaxSpeedThisTurn();
 	if (getFuel() == 1) { // avoid emptying
 		speed = min(1, speed);	
@@ -288,24 +393,66 @@ void Ship::doMoveOrder() {
 	if (isInTaskForce()) { // lead task force
 		speed = min(speed, taskForce->getMaxSpeedThisTurn());
 	}
-	
-	// Try to perform movement
-	for (int step = 0; step < speed; step++) {
-		if (!route.empty()) {
-			auto next = route.back();
-			route.pop_back();
-			assert(isAdjacent(next));
-			position = next;
-			logNow().moves.push_back(position);
-			updateOrders();
+	return speed;
+}
+
+// Predict how many spaces we can move on a later turn
+//   For timed routes: assumes fuel & damage as now
+//   (if we move less, we replot)
+int Ship::predictMoveSpeed(int turnsAhead, bool movedFast) const {
+	if (turnsAhead == 0) {
+		return getMoveSpeedThisTurn();
+	}
+	int speed = predictMaxSpeed(turnsAhead, movedFast);
+	if (getFuel() == 1) {
+		speed = min(1, speed);	
+	}
+	if (isInTaskForce()) {
+		for (int i = 0; i < taskForce->getSize(); i++) {
+			speed = min(speed, taskForce->getShip(i)
+				->predictMaxSpeed(turnsAhead, movedFast));
 		}
 	}
+	return speed;
+}
+
+// Predict our max speed on a later turn (no breakout bonus)
+int Ship::predictMaxSpeed(int turnsAhead, bool movedFast) const {
+	auto& game = context->getDirector();
+	return calcMaxSpeed(getMaxSpeedClass(), movedFast, getFuel(),
+		game.isConvoyTurn(game.getTurn() + turnsAhead));
+}
+
+// Compute max speed for a speed class & situation
+//   Out of fuel, or speed class 1, is emergency speed (Rule 5.24)
+int Ship::calcMaxSpeed(int speedClass, bool movedFast, 
+	int fuel, bool convoyTurn) 
+{
+	switch (fuel ? speedClass : 1) {
+		case 0: return 0;
+		case 1: return convoyTurn ? 1 : 0;
+		case 2: return 1;
+		case 3: return movedFast ? 1 : 2;
+		default: cerr << "Error: Unhandled speed class\n";
+			return 0;
+	}
 }
 
 // Get the max speed class on the search board
+int Ship::getMaxSpeedClass() const {
+	return state.maxSpeedClass;
+}
+
+// Recompute our speed class after evasion changes
+void Ship::updateSpeedClass() {
+	state.maxSpeedClass = calcMaxSpeedClass();
+	markCacheStale();
+}
+
+// Compute the max speed class on the search board
 //   See Basic Game Tables Card: Movement on Search Board
 //   This is effectively in half-zone units per turn
-int Ship::getMaxSpeedClass() const {
+int Ship::calcMaxSpeedClass() const {
 	int evasion = getEvasion();
 	if (evasion <= 6) return 0;
 	else if (evasion <= 15) return 1;
@@ -322,6 +469,14 @@ int Ship::getMaxSpeedClass() const {
 
 // How many board spaces can we move this turn?
 int Ship::getMaxSpeedThisTurn() const {
+	if (turnCache.stale) {
+		fillTurnCache();
+	}
+	return turnCache.maxSpeedThisTurn;
+}
+
+// Compute how many board spaces we can move this turn
+int Ship::calcMaxSpeedThisTurn() const {
 
 	// No move after convoy sunk (Rule 10.25)
 	if (wasConvoySunk(1)) {
@@ -339,49 +494,46 @@ int Ship::getMaxSpeedThisTurn() const {
 	}
 	
 	// Standard cases (Basic Game Tables Card)
-	switch(getMaxSpeedClass()) {
-		case 0: return 0;
-		case 1: return getEmergencySpeedThisTurn();
-		case 2: return 1;
-		case 3: return log.rbegin()[1].moves.size() > 1 ? 1 : 2;
-		default: cerr << "Error: Unhandled speed class\n";
-			return 0;
-	}
+	return calcMaxSpeed(getMaxSpeedClass(), movedFastLastTurn(), 
+		getFuel(), context->getDirector().isConvoyTurn());
+}
+
+// Did we move more than one zone last turn?
+bool Ship::movedFastLastTurn() const {
+	auto lastTurn = getLog(1);
+	return lastTurn && lastTurn->numMoves > 1;
 }
 
 // How far can emergency movement take us this turn? (Rule 5.24)
 int Ship::getEmergencySpeedThisTurn() const {
-	return GameDirector::instance()->isConvoyTurn() ? 1 : 0;
+	return context->getDirector().isConvoyTurn() ? 1 : 0;
 }
 
 // Are we in a friendly port?
 //   Note that we're not considered in port until 
 //   the turn after we enter the port zone (Rule 12.7)
 bool Ship::isInPort() const {
-	return SearchBoard::instance()->isGermanPort(position)
+	return context->getBoard().isGermanPort(state.position)
 		&& !isEnteringPort();
 }
 
 // Did we enter a friendly port zone on our most recent move?
 bool Ship::isEnteringPort() const {
-	return !log.empty()
-		&& !log.back().moves.empty()
-		&& SearchBoard::instance()->isGermanPort(
-			log.back().moves.back());
+	auto thisTurn = getLog(0);
+	return thisTurn && thisTurn->numMoves
+		&& context->getBoard().isGermanPort(
+			thisTurn->moves[thisTurn->numMoves - 1]);
 }
 
 // Is this zone accessible to German ships?
 //   Note coastal zones allowed by errata (vs. Terrain Effects Chart)
 bool Ship::isAccessible(const GridCoordinate& zone) const {
-	auto board = SearchBoard::instance();
-	return board->isSeaZone(zone)           // Rule 5.17
-		&& !board->isIrishSea(zone)         // Rule 5.18
-		&& !board->isBritishPort(zone);     // Rule 5.18
+	return context->getBoard().isGermanAccessible(zone);
 }
 
 // Did we move into/through a given zone this turn?
 bool Ship::movedThrough(const GridCoordinate& zone) const {
-	return hasElem(log.back().moves, zone);
+	return getLog(0)->hasMove(zone);
 }
 
 // Are we afloat?
@@ -402,12 +554,12 @@ bool Ship::isInDay() const {
 
 // Are we in the night?
 bool Ship::isInNight() const {
-	return GameDirector::instance()->isInNight(position);
+	return context->getDirector().isInNight(state.position);
 }
 
 // Are we in fog?
 bool Ship::isInFog() const {
-	return GameDirector::instance()->isInFog(position);
+	return context->getDirector().isInFog(state.position);
 }
 
 // Note that we have been detected by any means:
@@ -415,17 +567,17 @@ bool Ship::isInFog() const {
 //   but not reveal for convoy attack.
 //   Used for statistical models (not part of game).
 void Ship::setDetected() {
-	timesDetected++;
+	state.timesDetected++;
 }
 
 // Check how many times we were detected by any means
 int Ship::getTimesDetected() const {
-	return timesDetected;	
+	return state.timesDetected;	
 }
 
 // Note that we have been located by search/shadow
 void Ship::setLocated() {
-	logNow().located = true;
+	setLogFlag(logNow().located, GameHash::SHIP_LOCATED);
 	setDetected();
 }
 
@@ -433,51 +585,105 @@ void Ship::setLocated() {
 //   And so we have moved earlier in the turn (Rule 8.11)
 //   Compare to Shadow marker usage (Rule 2.53)
 void Ship::setShadowed() {
-	logNow().shadowed = true;
+	setLogFlag(logNow().shadowed, GameHash::SHIP_SHADOWED);
 }
 
 // Note that we have entered naval combat
 void Ship::setCombated() {
-	logNow().combated = true;
+	setLogFlag(logNow().combated, GameHash::SHIP_COMBATED);
 }
 
 // Note that we (helped) sank a convoy
 void Ship::setConvoySunk() {
-	logNow().convoySunk = true;	
+	setLogFlag(logNow().convoySunk, GameHash::SHIP_CONVOY_SUNK);
+}
+
+// Set a flag in this turn's log record
+void Ship::setLogFlag(bool& flag, GameHash::Feature feature) {
+	if (!flag) {
+		flag = true;
+		updateHash(GameHash::key(feature, hashId, state.turnsLogged));
+	}
 }
 
 // Check if we were located by search/shadow on a given turn
 bool Ship::wasLocated(unsigned turnsAgo) const {
-	return turnsAgo < log.size() ?
-		log.rbegin()[turnsAgo].located : false;
+	auto turn = getLog(turnsAgo);
+	return turn ? turn->located : false;
 }
 
 // Check if we were shadowed on a given turn
 bool Ship::wasShadowed(unsigned turnsAgo) const {
-	return turnsAgo < log.size() ?
-		log.rbegin()[turnsAgo].shadowed : false;
+	auto turn = getLog(turnsAgo);
+	return turn ? turn->shadowed : false;
 }
 
 // Check if we were in naval combat on a given turn
 bool Ship::wasCombated(unsigned turnsAgo) const {
-	return turnsAgo < log.size() ?
-		log.rbegin()[turnsAgo].combated : false;
+	auto turn = getLog(turnsAgo);
+	return turn ? turn->combated : false;
 }
 
 // Check if we (helped) sank a convoy on a given turn
 bool Ship::wasConvoySunk(unsigned turnsAgo) const {
-	return turnsAgo < log.size() ?
-		log.rbegin()[turnsAgo].convoySunk : false;
+	auto turn = getLog(turnsAgo);
+	return turn ? turn->convoySunk : false;
 }
 
 // How far did we move on the search board this turn?
 int Ship::getSpeedThisTurn() const {
-	return log.back().moves.size();
+	return getLog(0)->numMoves;
+}
+
+// Get one of our moves this turn (in order)
+GridCoordinate Ship::getMoveThisTurn(int idx) const {
+	assert(idx < getSpeedThisTurn());
+	return getLog(0)->moves[idx];
 }
 
 // Return the log record for the current turn
 Ship::LogTurn& Ship::logNow() {
-	return log.back();	
+	assert(state.turnsLogged);
+	return state.log[(state.turnsLogged - 1) % LOG_TURNS];	
+}
+
+// Return the log record for a recent turn
+//   Null if before we started or older than we keep
+const Ship::LogTurn* Ship::getLog(unsigned turnsAgo) const {
+	if (turnsAgo >= (unsigned) min(state.turnsLogged, (int) LOG_TURNS)) {
+		return nullptr;
+	}
+	return &state.log[(state.turnsLogged - 1 - turnsAgo) % LOG_TURNS];
+}
+
+// Add a move to the log record
+void Ship::LogTurn::addMove(const GridCoordinate& zone) {
+	assert(numMoves < MAX_MOVES);
+	moves[numMoves++] = zone;
+}
+
+// Copy moves from another log record (our task force leader's)
+void Ship::LogTurn::copyMoves(const LogTurn& other) {
+	copy(other.moves, other.moves + other.numMoves, moves);
+	numMoves = other.numMoves;
+}
+
+// Did we move into/through a given zone in the log record?
+bool Ship::LogTurn::hasMove(const GridCoordinate& zone) const {
+	return find(moves, moves + numMoves, zone) != moves + numMoves;
+}
+
+// Trace our moves this turn in the log
+//   (full history kept only in the log, if requested)
+void Ship::traceMoves() const {
+	auto thisTurn = getLog(0);
+	if (thisTurn->numMoves) {
+		clog << name << " moved";
+		for (int i = 0; i < thisTurn->numMoves; i++) {
+			clog << " " << thisTurn->moves[i];
+		}
+		clog << endl;
+	}
 }
 
 // Receive a non-move order
@@ -489,16 +695,20 @@ void Ship::orderAction(OrderType type) {
 
 // Receive a movement order
 //   Ignored if we're already there
-void Ship::orderMove(const GridCoordinate& dest) {
-	if (position != dest) {
-		Order order = {MOVE, dest};
+//   Risk scale above zero routes around hazardous zones;
+//   timed routes also plan when to move (e.g., wait for night)
+void Ship::orderMove(const GridCoordinate& dest, int riskScale, 
+	bool timed) 
+{
+	if (state.position != dest) {
+		Order order = {MOVE, dest, riskScale, timed};
 		pushOrder(order);
 	}
 }
 
 // Push a new order onto our queue
 void Ship::pushOrder(Order order) {
-	orders.push(order);
+	state.orders.push_back(order);
 	clog << name << " ordered to " << order.toString() << endl;
 }
 
@@ -506,12 +716,12 @@ void Ship::pushOrder(Order order) {
 void Ship::updateOrders() {
 
 	// If we achieved move destination, cycle to next
-	while (!orders.empty()
-		&& orders.front().type == MOVE
-		&& orders.front().zone == position)
+	while (!state.orders.empty()
+		&& state.orders.front().type == MOVE
+		&& state.orders.front().zone == state.position)
 	{
-		assert(route.empty());
-		orders.pop();
+		assert(state.route.empty());
+		state.orders.pop_front();
 	}
 	
 	// Note: Do NOT ask for new orders at this point (if empty)
@@ -520,14 +730,14 @@ void Ship::updateOrders() {
 
 // Do we have any pending orders?
 bool Ship::hasOrders() const {
-	return !orders.empty();	
+	return !state.orders.empty();	
 }
 
 // Clear the pending orders list
 void Ship::clearOrders() {
-	queue<Order> empty;
-	swap(orders, empty);
-	route.clear();
+	state.orders.clear();
+	state.route.clear();
+	state.turnMoves.clear();
 }
 
 // Get a string descriptor for an order
@@ -541,27 +751,24 @@ string Ship::Order::toString() const {
 }
 
 // Get a random nearby space to which we can move
+//   Any within given moves by sea (but not a German port)
 GridCoordinate Ship::randMoveInArea(int radius) const {
-	auto board = SearchBoard::instance();
-	GridCoordinate move = GridCoordinate::OFFBOARD;
-	while (!isAccessible(move) || board->isGermanPort(move)) {
-		move = board->randSeaZone(position, radius);
-	}
-	return move;
+	auto& board = context->getBoard();
+	auto moves = board.getReach(state.position, radius)
+		- board.getLayer(SearchBoard::GermanPorts);
+	return moves.randZoneOn(context->getRandom(GameContext::GERMAN_AI));
 }
 
 // Return type of the frontmost order
 Ship::OrderType Ship::getFirstOrder() const {
 	assert(hasOrders());
-	return orders.front().type;
+	return state.orders.front().type;
 }
 
 // Compute the fuel we expend at a given speed
 //   Does not include optional variation for weather (Rule 16.4),
 //   which refers back here (would be recursive call)
 int Ship::getFuelExpense(int speed) const {
-	int expense;
-	auto game = GameDirector::instance();
 
 	// First-turn breakout bonus (Rule 5.28)
 	if (isOnBreakoutBonus()) {
@@ -574,42 +781,51 @@ int Ship::getFuelExpense(int speed) const {
 	}
 
 	// Handle normal cases
-	assert(speed <= 2);
+	return calcFuelExpense(getFuelUse(), speed, 
+		context->getDirector().isConvoyTurn());
+}
+
+// How does our movement expend fuel?
+Ship::FuelUse Ship::getFuelUse() const {
 	switch (getGeneralType()) {
 	
 		case BATTLESHIP: case CARRIER:
-			// Rule 5.21
-			expense = (speed < 2) ? 0 : 1;
-
 			// Slow battleship: Rules 5.25 & 5.27
-			if (evasionMax <= 24 && speed == 1
-				&& !game->isConvoyTurn()) 
-			{
-				expense = 1;
-			}
-			return expense;
+			return evasionMax <= 24 ? SLOW_BB_FUEL_USE : FAST_FUEL_USE;
 	
 		case CRUISER:
-			// Rule 5.21
-			expense = 0;
-		
 			// Optional fuel expenditure: Rule 16.2
-			if (CmdArgs::instance()->useOptFuelExpenditure()) {
-				expense = (speed < 2) ? 0 : 1;
-			}
-			return expense;
+			return context->getArgs().useOptFuelExpenditure() ?
+				FAST_FUEL_USE : NO_FUEL_USE;
 
 		case DESTROYER:
-			// Rule 23.21
-			return speed < 2 ? 1 : 3;
+			return DESTROYER_FUEL_USE;
 
 		case SUBMARINE:
 			// Rule 22.14
-			return 0;
+			return NO_FUEL_USE;
 			
 		default:
 			cerr << "Error: Unhandled ship class type\n";
 			assert(false);
+			return NO_FUEL_USE;
+	}
+}
+
+// Compute the fuel expended at a given speed (no breakout bonus)
+int Ship::calcFuelExpense(FuelUse fuelUse, int speed, bool convoyTurn) {
+	assert(speed <= 2);
+	switch (fuelUse) {
+		case FAST_FUEL_USE: 
+			// Rule 5.21
+			return speed < 2 ? 0 : 1;
+		case SLOW_BB_FUEL_USE: 
+			// Slow battleship: Rules 5.21, 5.25 & 5.27
+			return speed == 2 || (speed == 1 && !convoyTurn) ? 1 : 0;
+		case DESTROYER_FUEL_USE: 
+			// Rule 23.21
+			return speed < 2 ? 1 : 3;
+		default: 
 			return 0;
 	}
 }
@@ -617,8 +833,8 @@ int Ship::getFuelExpense(int speed) const {
 // Expend extra fuel at bad visibility levels
 //   As per optional Rule 16.4 on Fuel Expenditure
 void Ship::checkFuelForWeather(int speed) {
-	if (CmdArgs::instance()->useOptFuelExpenditure()) {
-		int visibility = GameDirector::instance()->getVisibility();
+	if (context->getArgs().useOptFuelExpenditure()) {
+		int visibility = context->getDirector().getVisibility();
 		switch (getGeneralType()) {
 
 			case BATTLESHIP: 
@@ -650,9 +866,10 @@ void Ship::checkFuelForWeather(int speed) {
 // Check for fuel lost from combat damage
 //   As per optional Rule 21.0 on Fuel Damage
 void Ship::checkFuelDamage(int midshipsLoss) {
-	if (CmdArgs::instance()->useOptFuelDamage()) {
+	if (context->getArgs().useOptFuelDamage()) {
+		auto& random = context->getRandom(GameContext::CHANCE);
 		for (int i = 0; i < midshipsLoss; i++) {
-			if (dieRoll(6) >= 5) {
+			if (random.dieRoll(6) >= 5) {
 				loseFuel(1);
 			}
 		}
@@ -660,87 +877,295 @@ void Ship::checkFuelDamage(int midshipsLoss) {
 }
 
 // Get a route from the Navigator
-void Ship::plotRoute(const GridCoordinate& goal) {
-	route.clear();
-	if (goal == GridCoordinate::OFFBOARD) {
-		assert(position.getRow() == 'Z');
-		route.push_back(goal);
+//   Timed route if ordered (and one is found), else untimed
+void Ship::plotRoute(const Order& order) {
+	state.route.clear();
+	state.turnMoves.clear();
+	if (order.zone == GridCoordinate::OFFBOARD) {
+		assert(state.position.getRow() == 'Z');
+		state.route.push_back(order.zone);
 	}
-	else {
-		route = Navigator::findSeaRoute(*this, goal);
+	else if (!order.timed || !plotTimedRoute(order)) {
+		Navigator::findSafeSeaRoute(context->getBoard(), state.position, 
+			order.zone, order.riskScale, 
+			context->getRandom(GameContext::GERMAN_AI), state.route);
 	}
 }
 
+// Get a timed route from the Navigator
+//   Planned for night as scheduled & fog as now,
+//   so only needs replotting if fog changes or we fall behind
+bool Ship::plotTimedRoute(const Order& order) {
+	auto& game = context->getDirector();
+	bool movedFast = movedFastLastTurn();
+	state.timedRouteFogDependent = false;
+	bool found = Navigator::findTimedSeaRoute(context->getBoard(), 
+		state.position, order.zone, movedFast,
+		[this](int turn, bool fast) { return predictMoveSpeed(turn, fast); },
+		[this, &order](int zone, int turn) { 
+			return getTurnCost(zone, turn, order.riskScale, 
+				state.timedRouteFogDependent); 
+		},
+		context->getRandom(GameContext::GERMAN_AI), 
+		state.route, state.turnMoves);
+	state.timedRouteTurn = game.getTurn();
+	state.timedRouteFoggy = game.isFoggy();
+	return found;
+}
+
+// Is our timed route (if any) still on schedule?
+bool Ship::isOnTimedSchedule() const {
+	auto& game = context->getDirector();
+	return state.turnMoves.empty()
+		|| (state.timedRouteTurn == game.getTurn()
+			&& (!state.timedRouteFogDependent 
+				|| state.timedRouteFoggy == game.isFoggy()));
+}
+
+// Get cost to end a later turn in a zone (for timed routes)
+//   Base move cost per turn (as for safe routes), plus risk times 
+//   general search column, if one could be made there then 
+//   (Rules 10.211, 10.213, 11.13); notes if fog decided it
+int Ship::getTurnCost(int zone, int turnsAhead, int riskScale,
+	bool& fogDependent) const 
+{
+	auto& game = context->getDirector();
+	auto& board = context->getBoard();
+	auto coord = GridCoordinate::fromIndex(zone);
+	int cost = Navigator::BASE_MOVE_COST;
+	if (board.isInsidePatrolLine(coord)
+		&& !game.isInNight(coord, game.getTurn() + turnsAhead))
+	{
+		if (board.isFogZone(coord)) {
+			fogDependent = true;
+			if (game.isFoggy()) {
+				return cost;
+			}
+		}
+		int column = board.getGeneralSearchColumn(coord) - 'A';
+		cost += riskScale * (column + 1);
+	}
+	return cost;
+}
+
 // Set the return to base (RTB) marker (Rule 16.3)
 void Ship::setReturnToBase() {
-	returnToBase = true;	
+	rehash(GameHash::SHIP_RETURN_TO_BASE, state.returnToBase, true);
+	state.returnToBase = true;	
 }
 
 // Is the return to base (RTB) marker set?
 bool Ship::isReturnToBase() const {
-	return returnToBase;	
+	return state.returnToBase;	
 }
 
 // Are we using the breakout bonus first-turn move (Rule 5.28)?
 bool Ship::isOnBreakoutBonus() const {
-	return GameDirector::instance()->isStartTurn();
+	return context->getDirector().isStartTurn();
+}
+
+// Get our part of the game state
+const Ship::State& Ship::getState() const {
+	return state;
+}
+
+// Compute our part of the game hash from scratch
+//   (see GameDirector::calcHash)
+uint64_t Ship::calcHash() const {
+	uint64_t hash = GameHash::key(GameHash::SHIP_ZONE, hashId, state.position.index())
+		^ GameHash::key(GameHash::SHIP_FUEL_LOST, hashId, state.fuelLost)
+		^ GameHash::key(GameHash::SHIP_MIDSHIPS_LOST, hashId, 
+			state.midshipsLost)
+		^ GameHash::key(GameHash::SHIP_EVASION_LOST_TEMP, hashId,
+			state.evasionLostTemp)
+		^ GameHash::key(GameHash::SHIP_EVASION_LOST_PERM, hashId,
+			state.evasionLostPerm);
+	hash ^= GameHash::key(GameHash::SHIP_ON_PATROL, hashId, state.onPatrol)
+		^ GameHash::key(GameHash::SHIP_RETURN_TO_BASE, hashId,
+			state.returnToBase)
+		^ GameHash::key(GameHash::SHIP_TASK_FORCE, hashId, 
+			getTaskForceId());
+	int firstLogTurn = max(1, state.turnsLogged - LOG_TURNS + 1);
+	for (int logTurn = firstLogTurn; logTurn <= state.turnsLogged; 
+		logTurn++) 
+	{
+		hash ^= calcLogHash(logTurn);
+	}
+	return hash;
+}
+
+// Compute hash keys for the flags set in one turn's log record
+//   (turns logged count from 1), & its move count
+//   (zones moved are only read in the turn they're logged)
+uint64_t Ship::calcLogHash(int logTurn) const {
+	auto& log = state.log[(logTurn - 1) % LOG_TURNS];
+	uint64_t hash = getLogMovesKey(logTurn, log.numMoves);
+	if (log.located) {
+		hash ^= GameHash::key(GameHash::SHIP_LOCATED, hashId, logTurn);
+	}
+	if (log.shadowed) {
+		hash ^= GameHash::key(GameHash::SHIP_SHADOWED, hashId, logTurn);
+	}
+	if (log.combated) {
+		hash ^= GameHash::key(GameHash::SHIP_COMBATED, hashId, logTurn);
+	}
+	if (log.convoySunk) {
+		hash ^= GameHash::key(GameHash::SHIP_CONVOY_SUNK, hashId, logTurn);
+	}
+	return hash;
+}
+
+// Get the hash key for a turn's move count (none if zero)
+uint64_t Ship::getLogMovesKey(int logTurn, int numMoves) const {
+	return numMoves ? GameHash::key(GameHash::SHIP_MOVES, hashId, 
+		logTurn * (LogTurn::MAX_MOVES + 1) + numMoves) : 0;
+}
+
+// Update the game hash for a change to this turn's move count
+void Ship::rehashLogMoves(int oldNumMoves) {
+	updateHash(getLogMovesKey(state.turnsLogged, oldNumMoves)
+		^ getLogMovesKey(state.turnsLogged, logNow().numMoves));
+}
+
+// Update the game hash for a change to one of our features
+void Ship::rehash(GameHash::Feature feature, int oldValue, int newValue) {
+	updateHash(GameHash::change(feature, hashId, oldValue, newValue));
+}
+
+// Update the game hash by the given keys
+//   Only ships in a player's fleet are part of the game state
+void Ship::updateHash(uint64_t keys) {
+	if (player) {
+		context->getDirector().updateHash(keys);
+	}
+}
+
+// Restore our part of the game state
+//   (task force links are restored by our player)
+void Ship::restoreState(const State& saved) {
+	memcpy(&state, &saved, sizeof state);
+	turnCache.stale = true;
 }
 
 // Join a task force
 void Ship::joinTaskForce(TaskForce* taskForce) {
+	rehash(GameHash::SHIP_TASK_FORCE, getTaskForceId(), 
+		taskForce->getId());
 	this->taskForce = taskForce;
 }
 
 // Leave a task force
 void Ship::leaveTaskForce() {
+	rehash(GameHash::SHIP_TASK_FORCE, getTaskForceId(), 0);
 	taskForce = nullptr;
 }
 
+// Get the ID number of our task force (zero if none)
+int Ship::getTaskForceId() const {
+	return taskForce ? taskForce->getId() : 0;
+}
+
 // Are we in a task force?
 bool Ship::isInTaskForce() const { 
 	return taskForce != nullptr;
 }
 
-// How many search board spaces can we move per turn?
-float Ship::getMaxSpeedAvg() const {
-	float speed = (float) getMaxSpeedClass() / 2;
-	switch (getFuel()) {
-		case 0: speed = min(speed, 0.5f); break;
-		case 1: speed = min(speed, 1.0f); break;	
-	}
-	return speed;
-}
-
 // What turn is the earliest we could reach a convoy route zone?
+//   Distance by sea, precomputed on the board
 int Ship::convoyETA() const {
-	int minDist = INT_MAX;
-	auto convoyZones = SearchBoard::instance()->getAllConvoyRoutes();	
-	for (auto zone: convoyZones) {
-		int distance = position.distanceFrom(zone);
-		if (distance < minDist) {
-			minDist = distance;	
-		}
-	}
-	int turnsToGo = (int) (minDist / getMaxSpeedAvg());
-	return GameDirector::instance()->getTurn() + turnsToGo;
+	int distance = context->getBoard().getSeaDistance(
+		state.position, SearchBoard::ToConvoyRoutes);
+	return context->getDirector().getTurn() + getTurnsToGo(distance);
 }
 
 // What turn should we arrive at end of our plotted route?
 int Ship::routeETA() const {
-	int turnsToGo = (int) (route.size() / getMaxSpeedAvg());
-	return GameDirector::instance()->getTurn() + turnsToGo;
+	return context->getDirector().getTurn() + getTurnsToGo(state.route.size());
 }
 
 // What turn could we get to row Z? (note Rule 51.6)
+//   Distance by sea, precomputed on the board
 int Ship::rowZ_ETA() const {
-	int distance = 'Z' - position.getRow();
-	int turnsToGo = (int) (distance / getMaxSpeedAvg());
-	return GameDirector::instance()->getTurn() + turnsToGo;
+	int distance = context->getBoard().getSeaDistance(
+		state.position, SearchBoard::ToRowZ);
+	return context->getDirector().getTurn() + getTurnsToGo(distance);
+}
+
+// How many turns to move a given distance, at our best speed?
+//   Exact for alternating fast moves, convoy turns & fuel use,
+//   but assumes no damage, breakout bonus, or task force
+int Ship::getTurnsToGo(int distance) const {
+	return calcTurnsToGo(getFuelUse(), getMaxSpeedClass(), 
+		movedFastLastTurn(), getFuel(), 
+		context->getDirector().isConvoyTurn(), distance);
+}
+
+// Look up turns to move a given distance (NEVER_ARRIVES if can't)
+//   Fuel over table max is treated as the max (conservative)
+int Ship::calcTurnsToGo(FuelUse fuelUse, int speedClass, 
+	bool movedFast, int fuel, bool convoyTurn, int distance)
+{
+	if (distance < 0 || distance > MAX_ETA_DISTANCE
+		|| speedClass < 0 || speedClass >= NUM_SPEED_CLASSES)
+	{
+		return NEVER_ARRIVES;
+	}
+	fuel = min(max(fuel, 0), (int) MAX_ETA_FUEL);
+	return getArrivalTable().turnsToGo[fuelUse][speedClass]
+		[movedFast][fuel][convoyTurn][distance];
+}
+
+// Get the table of arrival turns (built on first use)
+const Ship::ArrivalTable& Ship::getArrivalTable() {
+	static const ArrivalTable table;
+	return table;
+}
+
+// Build the table of arrival turns
+//   By distance ascending; each turn we may move any number
+//   of zones up to max speed (capped at 1 on last fuel, as we move).
+//   Stopping can lead to a faster move next turn, 
+//   so relax each distance until no entry improves.
+Ship::ArrivalTable::ArrivalTable() {
+	memset(turnsToGo, NEVER_ARRIVES, sizeof(turnsToGo));
+	for (int dist = 0; dist <= MAX_ETA_DISTANCE; dist++) {
+		bool changed;
+		do {
+			changed = false;
+			for (int use = 0; use < NUM_FUEL_USES; use++)
+			for (int speedClass = 0; speedClass < NUM_SPEED_CLASSES; 
+				speedClass++)
+			for (int fast = 0; fast < 2; fast++)
+			for (int fuel = 0; fuel <= MAX_ETA_FUEL; fuel++)
+			for (int convoyTurn = 0; convoyTurn < 2; convoyTurn++) {
+				auto& entry = turnsToGo[use][speedClass][fast][fuel]
+					[convoyTurn][dist];
+				if (!dist) {
+					entry = 0;
+					continue;
+				}
+				int speed = calcMaxSpeed(speedClass, fast, fuel, convoyTurn);
+				if (fuel == 1) {
+					speed = min(1, speed);
+				}
+				for (int moves = 0; moves <= min(speed, dist); moves++) {
+					int fuelLeft = max(0, fuel - calcFuelExpense(
+						(FuelUse) use, moves, convoyTurn));
+					int next = turnsToGo[use][speedClass][moves > 1]
+						[fuelLeft][!convoyTurn][dist - moves];
+					if (next + 1 < entry) {
+						entry = next + 1;
+						changed = true;
+					}
+				}
+			}
+		} while (changed);
+	}
 }
 
 // Are we adjacent to this zone?
 bool Ship::isAdjacent(const GridCoordinate& zone) const {
 	return zone == GridCoordinate::OFFBOARD ?
-		position.getRow() == 'Z': 
-		position.distanceFrom(zone) == 1;
+		state.position.getRow() == 'Z': 
+		state.position.distanceFrom(zone) == 1;
 }
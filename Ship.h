@@ -9,15 +9,19 @@
 #define SHIP_H
 #include "GridCoordinate.h"
 #include "NavalUnit.h"
+#include "Navigator.h"
+#include "InlineVector.h"
+#include "GameHash.h"
 #include <vector>
-#include <queue>
+#include <cstdint>
 
 // Forwards
 class GermanPlayer;
 class TaskForce;
+class GameContext;
 
 // Ship class
-class Ship: public NavalUnit
+class Ship final: public NavalUnit
 {
 	public:
 		
@@ -25,9 +29,19 @@ class Ship: public NavalUnit
 		enum Type {BB, BC, PB, CV, CA, CL, DD, CT, SS, UB};
 		enum GeneralType {BATTLESHIP, CARRIER, CRUISER, DESTROYER, SUBMARINE};
 		enum OrderType {MOVE, PATROL, STOP};
+		enum FuelUse {NO_FUEL_USE, FAST_FUEL_USE, SLOW_BB_FUEL_USE, 
+			DESTROYER_FUEL_USE, NUM_FUEL_USES};
+
+		// Constants
+		static const int NUM_SPEED_CLASSES = 4;
+		static const int MAX_ETA_FUEL = 15;
+		static const int MAX_ETA_DISTANCE = 63;
+		static const int NEVER_ARRIVES = UINT8_MAX;
+		static const int MAX_ORDERS = 8;
 
 		// Constructor
-		Ship(std::string name, Type type, 
+		Ship(GameContext& context,
+			std::string name, Type type, 
 			int evasion, int midships, int fuel, 
 			GridCoordinate position = GridCoordinate::OFFBOARD,
 			GermanPlayer* player = nullptr);
@@ -35,10 +49,12 @@ class Ship: public NavalUnit
 		// Accessors
 		Type getType() const;
 		GeneralType getGeneralType() const;
+		FuelUse getFuelUse() const;
 		std::string getGeneralTypeName() const;
 		int getFuel() const;
 		int getMidships() const;
 		int getTimesDetected() const;
+		uint64_t calcHash() const;
 
 		// Mutator functions
 		void doAvailability();
@@ -55,14 +71,21 @@ class Ship: public NavalUnit
 
 		// Plotting functions
 		void orderAction(OrderType type);
-		void orderMove(const GridCoordinate& dest);
+		void orderMove(const GridCoordinate& dest, int riskScale = 0,
+			bool timed = false);
 		void clearOrders();
 		bool hasOrders() const;
 		OrderType getFirstOrder() const;
-		float getMaxSpeedAvg() const;
 		int convoyETA() const;
 		int routeETA() const;
 		int rowZ_ETA() const;
+		int getTurnsToGo(int distance) const;
+		static int calcTurnsToGo(FuelUse fuelUse, int speedClass, 
+			bool movedFast, int fuel, bool convoyTurn, int distance);
+		static int calcMaxSpeed(int speedClass, bool movedFast, 
+			int fuel, bool convoyTurn);
+		static int calcFuelExpense(FuelUse fuelUse, int speed, 
+			bool convoyTurn);
 		
 		// Task force membership
 		void joinTaskForce(TaskForce* taskForce);
@@ -79,6 +102,7 @@ class Ship: public NavalUnit
 		std::string getTypeDesc() const override;
 		std::string getNameDesc() const override;
 		std::string getFullDesc() const override;
+		void printFullDesc(std::ostream& stream) const;
 		
 		// Accessors
 		virtual Ship* getShip(int idx) override;
@@ -89,6 +113,7 @@ class Ship: public NavalUnit
 		int getMaxSpeedClass() const override;
 		int getMaxSpeedThisTurn() const override;
 		int getSpeedThisTurn() const override;
+		GridCoordinate getMoveThisTurn(int idx) const;
 		int getEvasion() const override;
 		int getAttackEvasion() const override;
 		int getSearchStrength() const override;
@@ -127,36 +152,97 @@ class Ship: public NavalUnit
 		struct Order {
 			OrderType type = OrderType::STOP;
 			GridCoordinate zone = GridCoordinate::OFFBOARD;
+			int riskScale = 0; // for move route (see Navigator)
+			bool timed = false; // plan moves by turn
 			std::string toString() const;
 		};
 
 		// Logging structure
+		//   Moves inline: at most breakout bonus speed (Rule 5.28)
 		struct LogTurn {
-			std::vector<GridCoordinate> moves;
+			static const int MAX_MOVES = 5;
+			GridCoordinate moves[MAX_MOVES];
+			uint8_t numMoves = 0;
 			bool shadowed = false, located = false, 
 				combated = false, convoySunk = false;
+			void addMove(const GridCoordinate& zone);
+			void copyMoves(const LogTurn& other);
+			bool hasMove(const GridCoordinate& zone) const;
+		};
+
+		// Turns of log kept (game checks up to 2 turns ago)
+		static const int LOG_TURNS = 4;
+
+	public:
+		// Our part of the game state (see GameState)
+		//   Everything that changes in play; trivially copyable.
+		//   Task force membership is kept by the player.
+		struct State {
+			int fuelLost = 0;
+			int midshipsLost = 0;
+			int evasionLostTemp = 0, evasionLostPerm = 0;
+			int maxSpeedClass = 0; // changes only with evasion
+			int timesDetected = 0;
+			bool onPatrol = false;
+			bool returnToBase = false;
+			GridCoordinate position;
+			InlineVector<Order, MAX_ORDERS> orders; // first is front
+			Navigator::Route route;
+			Navigator::TurnMoves turnMoves; // timed route (last turn first)
+			int timedRouteTurn = -1; // next turn of timed route
+			bool timedRouteFoggy = false; // fog when planned...
+			bool timedRouteFogDependent = false; // ...& if fog mattered
+			LogTurn log[LOG_TURNS]; // ring buffer of recent turns
+			int turnsLogged = 0;
+		};
+		const State& getState() const;
+		void restoreState(const State& saved);
+
+	private:
+
+		// Turns to go by distance, for each fuel use, speed class,
+		//   fast move last turn, fuel & convoy turn
+		//   Computed once, shared by all ships
+		struct ArrivalTable {
+			uint8_t turnsToGo[NUM_FUEL_USES][NUM_SPEED_CLASSES][2]
+				[MAX_ETA_FUEL + 1][2][MAX_ETA_DISTANCE + 1];
+			ArrivalTable();
+		};
+
+		// Derived values for this turn
+		//   Filled in availability phase; marked stale by any change
+		//   to our fuel, damage, patrol or position in the turn
+		struct TurnCache {
+			bool stale = true;
+			int maxSpeedThisTurn = 0;
+			int searchStrength = 0;
 		};
 
 		// Data
 		std::string name;
+		uint32_t hashId; // our object in game hash keys
 		Type type;
-		int fuelMax, fuelLost;
-		int midshipsMax, midshipsLost;
-		int evasionMax, evasionLostTemp, evasionLostPerm;
+		int fuelMax, midshipsMax, evasionMax;
 		int evasionLossRate;
-		int timesDetected;
-		bool onPatrol;
-		bool returnToBase;
-		GridCoordinate position;
+		State state;
+		mutable TurnCache turnCache;
+		GameContext* context;
 		GermanPlayer* player;
 		TaskForce* taskForce;
-		std::queue<Order> orders;
-		std::vector<GridCoordinate> route;
-		std::vector<LogTurn> log;
 
 		// Functions
 		LogTurn& logNow();
+		const LogTurn* getLog(unsigned turnsAgo) const;
+		void traceMoves() const;
+		static const ArrivalTable& getArrivalTable();
+		bool movedFastLastTurn() const;
+		int calcMaxSpeedClass() const;
+		int calcMaxSpeedThisTurn() const;
+		int calcSearchStrength() const;
 		int getEmergencySpeedThisTurn() const;
+		int getMoveSpeedThisTurn() const;
+		int predictMoveSpeed(int turnsAhead, bool movedFast) const;
+		int predictMaxSpeed(int turnsAhead, bool movedFast) const;
 		int getFuelExpense(int speed) const;
 		bool isOnBreakoutBonus() const;
 		bool isAdjacent(const GridCoordinate& zone) const;
@@ -165,10 +251,25 @@ class Ship: public NavalUnit
 		void doPostMoveAccounts();
 		void pushOrder(Order order);
 		void setEvasionLossRate();
+		void updateSpeedClass();
+		void fillTurnCache() const;
+		void markCacheStale();
+		void setOnPatrol(bool onPatrol);
+		void setLogFlag(bool& flag, GameHash::Feature feature);
+		int getTaskForceId() const;
+		uint64_t calcLogHash(int logTurn) const;
+		uint64_t getLogMovesKey(int logTurn, int numMoves) const;
+		void rehashLogMoves(int oldNumMoves);
+		void rehash(GameHash::Feature feature, int oldValue, int newValue);
+		void updateHash(uint64_t keys);
 		void applyTempEvasionLoss(int midshipsLoss);
 		void checkFuelDamage(int midshipsLoss);
 		void checkFuelForWeather(int speed);
-		void plotRoute(const GridCoordinate& goal);
+		void plotRoute(const Order& order);
+		bool plotTimedRoute(const Order& order);
+		bool isOnTimedSchedule() const;
+		int getTurnCost(int zone, int turnsAhead, int riskScale,
+			bool& fogDependent) const;
 };
 
 // Stream insertion operator
@@ -1,12 +1,37 @@
 #include "TaskForce.h"
 #include "Utils.h"
 #include <cassert>
+#include <climits>
+#include <sstream>
 using namespace std;
 
 // Construct a new task force
+//   (our player announces the forming)
 TaskForce::TaskForce (int id) {
 	identifier = id;
-	clog << getName() << " forming\n";
+}
+
+// Save our part of the game state
+void TaskForce::saveState(State& state, const Ship* fleet) const {
+	assert((int) shipList.size() <= MAX_SHIPS);
+	state.identifier = identifier;
+	state.numShips = shipList.size();
+	for (unsigned i = 0; i < shipList.size(); i++) {
+		state.shipIdx[i] = shipList[i] - fleet;
+	}
+}
+
+// Restore our part of the game state
+//   Quietly (not forming anew), relinking our ships
+void TaskForce::restoreState(const State& state, Ship* fleet) {
+	identifier = state.identifier;
+	shipList.clear();
+	for (int i = 0; i < state.numShips; i++) {
+		Ship* ship = &fleet[state.shipIdx[i]];
+		shipList.push_back(ship);
+		ship->joinTaskForce(this);
+	}
+	markAggregatesStale();
 }
 
 // Destructor
@@ -23,6 +48,7 @@ void TaskForce::attach(Ship* ship) {
 	assert(ship->getGeneralType() != Ship::SUBMARINE); // Rule 22.14
 	shipList.push_back(ship);
 	ship->joinTaskForce(this);
+	markAggregatesStale();
 	clog << getName() << " attached " << ship->getName() << "\n";
 }
 
@@ -32,6 +58,7 @@ void TaskForce::detach(Ship* ship) {
 	assert(it != shipList.end());
 	shipList.erase(it);
 	ship->leaveTaskForce();
+	markAggregatesStale();
 	clog << getName() << " detached " << ship->getName() << "\n";
 }
 
@@ -95,24 +122,38 @@ string TaskForce::getName() const {
 
 // Get a description with only ship types
 string TaskForce::getTypeDesc() const {
+	ostringstream stream;
+	printTypeDesc(stream);
+	return stream.str();
+}
+
+// Print a description with only ship types
+//   (straight to stream, so logging builds no strings)
+void TaskForce::printTypeDesc(std::ostream& stream) const {
 	assert(!isEmpty());	
-	string desc = "Task Force (";
+	stream << "Task Force (";
 	for (unsigned i = 0; i < shipList.size(); i++) {
-		desc += (i ? ", " : "") + shipList[i]->getTypeDesc();
+		stream << (i ? ", " : "") << shipList[i]->getTypeDesc();
 	}
-	desc += ")";
-	return desc;
+	stream << ")";
 }
 
 // Get a description with ship names
 string TaskForce::getNameDesc() const {
+	ostringstream stream;
+	printNameDesc(stream);
+	return stream.str();
+}
+
+// Print a description with ship names
+//   (straight to stream, so logging builds no strings)
+void TaskForce::printNameDesc(std::ostream& stream) const {
 	assert(!isEmpty());	
-	string desc = getName() + " (";
+	stream << getName() << " (";
 	for (unsigned i = 0; i < shipList.size(); i++) {
-		desc += (i ? ", " : "") + shipList[i]->getName();
+		stream << (i ? ", " : "") << shipList[i]->getName();
 	}
-	desc += ")";
-	return desc;
+	stream << ")";
 }
 
 // Get a description with full information
@@ -137,76 +178,73 @@ int TaskForce::getSpeedThisTurn() const {
 
 // Get the max speed class on the search board
 int TaskForce::getMaxSpeedClass() const {
-	int lowest = INT_MAX;
-	for (auto& ship: shipList) {
-		int speedClass = ship->getMaxSpeedClass();
-		if (speedClass < lowest) {
-			lowest = speedClass;
-		}
-	}
-	assert(lowest < INT_MAX);
-	return lowest;
+	return getAggregates().maxSpeedClass;
 }
 
 // How many board spaces can we move this turn?
 int TaskForce::getMaxSpeedThisTurn() const {
-	int lowest = INT_MAX;
-	for (auto& ship: shipList) {
-		int speed = ship->getMaxSpeedThisTurn();
-		if (speed < lowest) {
-			lowest = speed;
-		}
-	}
-	assert(lowest < INT_MAX);
-	return lowest;
+	return getAggregates().maxSpeedThisTurn;
 }
 
 // Get the standard evasion level
 //   That is: Evasion of the slowest ship
 int TaskForce::getEvasion() const {
-	int lowest = INT_MAX;
-	for (auto& ship: shipList) {
-		int evasion = ship->getEvasion();
-		if (evasion < lowest) {
-			lowest = evasion;
-		}
-	}
-	assert(lowest < INT_MAX);
-	return lowest;
+	return getAggregates().evasion;
 }
 
 // Get the attack evasion level
 //   That is: Evasion of the fastest ship (Rule 9.222)
 int TaskForce::getAttackEvasion() const {
-	int highest = 0;
-	for (auto& ship: shipList) {
-		if (ship->getType() != Ship::CV) { // Errata
-			int evasion = ship->getEvasion();
-			if (evasion > highest) {
-				highest = evasion;
-			}
-		}
-	}
-	return highest;
+	return getAggregates().attackEvasion;
 }
 
 // Get our current search strength
 int TaskForce::getSearchStrength() const {
+	return getAggregates().searchStrength;
+}
+
+// Note a change to our ships (see Aggregates)
+void TaskForce::markAggregatesStale() {
+	aggregates.stale = true;
+}
 
-	// If on patrol, get highest ship strength (Rule 5.45)
-	if (isOnPatrol()) {
-		int highest = 0;
-		for (auto& ship: shipList) {
-			int strength = ship->getSearchStrength();
-			if (strength > highest) {
-				highest = strength;
-			}
+// Get our aggregates, recomputed if stale
+const TaskForce::Aggregates& TaskForce::getAggregates() const {
+	if (aggregates.stale) {
+		fillAggregates();
+	}
+	return aggregates;
+}
+
+// Compute aggregates over all ships
+void TaskForce::fillAggregates() const {
+	assert(!isEmpty());
+	auto& agg = aggregates;
+	agg.maxSpeedClass = INT_MAX;
+	agg.maxSpeedThisTurn = INT_MAX;
+	agg.evasion = INT_MAX;
+	agg.attackEvasion = 0;
+	agg.searchStrength = 0;
+	for (auto& ship: shipList) {
+		agg.maxSpeedClass = min(agg.maxSpeedClass, 
+			ship->getMaxSpeedClass());
+		agg.maxSpeedThisTurn = min(agg.maxSpeedThisTurn, 
+			ship->getMaxSpeedThisTurn());
+		agg.evasion = min(agg.evasion, ship->getEvasion());
+		if (ship->getType() != Ship::CV) { // Errata
+			agg.attackEvasion = max(agg.attackEvasion, 
+				ship->getEvasion());
 		}
-		return highest;
+		agg.searchStrength = max(agg.searchStrength, 
+			ship->getSearchStrength());
 	}
-	
-	// If not on patrol, strength is 1 (per game counters)
-	return 1;
+
+	// If on patrol, highest ship strength (Rule 5.45);
+	//   if not, strength is 1 (per game counters)
+	if (!isOnPatrol()) {
+		agg.searchStrength = 1;
+	}
+	agg.stale = false;
 }
 
 // Are any ships afloat?
@@ -17,11 +17,24 @@
 #define TASKFORCE_H
 #include "Ship.h"
 #include "NavalUnit.h"
-#include <vector>
+#include "InlineVector.h"
+#include <cstdint>
+#include <ostream>
 
-class TaskForce: public NavalUnit
+class TaskForce final: public NavalUnit
 {
 	public:
+		// Constants
+		static const int MAX_SHIPS = 6; // whole German fleet
+
+		// Our part of the game state (see GameState)
+		//   Ships by index in the fleet, flagship first
+		struct State {
+			int identifier;
+			int numShips;
+			uint8_t shipIdx[MAX_SHIPS];
+		};
+
 		// Construction
 		TaskForce(int id);
 		void attach(Ship* ship);
@@ -33,6 +46,9 @@ class TaskForce: public NavalUnit
 		int getId() const;
 		bool isEmpty() const;
 		void orderFollowers(Ship::OrderType order);
+		void markAggregatesStale();
+		void saveState(State& state, const Ship* fleet) const;
+		void restoreState(const State& state, Ship* fleet);
 		bool operator==(const TaskForce& other) const;
 
 		//
@@ -44,6 +60,8 @@ class TaskForce: public NavalUnit
 		std::string getTypeDesc() const override;
 		std::string getNameDesc() const override;
 		std::string getFullDesc() const override;
+		void printTypeDesc(std::ostream& stream) const;
+		void printNameDesc(std::ostream& stream) const;
 		
 		// Accessors
 		virtual Ship* getShip(int idx) override;
@@ -83,8 +101,26 @@ class TaskForce: public NavalUnit
 		void setDetected() override;
 		
 	private:
+		// Aggregates over our ships
+		//   Recomputed on next use after our membership changes,
+		//   or any ship's fuel, damage, patrol or position
+		struct Aggregates {
+			bool stale = true;
+			int maxSpeedClass = 0;
+			int maxSpeedThisTurn = 0;
+			int evasion = 0;
+			int attackEvasion = 0;
+			int searchStrength = 0;
+		};
+
+		// Data
 		int identifier;
-		std::vector<Ship*> shipList;
+		InlineVector<Ship*, MAX_SHIPS> shipList;
+		mutable Aggregates aggregates;
+
+		// Functions
+		const Aggregates& getAggregates() const;
+		void fillAggregates() const;
 };
 
 #endif
@@ -9,20 +9,117 @@
 #include <cassert>
 #include <ctime>
 #include "SearchBoard.h"
+#include "GameContext.h"
+#include "CmdArgs.h"
 #include "GridCoordinate.h"
 #include "Ship.h"
+#include "TaskForce.h"
 #include "Utils.h"
 #include "Navigator.h"
+#include "RandomStream.h"
+#include "RunningStat.h"
+#include "GameStream.h"
+#include "GameState.h"
+#include <cmath>
+#include <cstdlib>
+#include <new>
 using namespace std;
 
+// Count heap allocations (for allocation tests)
+static long numAllocs = 0;
+void* operator new(size_t size) {
+	numAllocs++;
+	void* ptr = malloc(size ? size : 1);
+	if (!ptr) {
+		throw bad_alloc();
+	}
+	return ptr;
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
 // Test SearchBoard
-void testSearchBoard() {
+void testSearchBoard(const SearchBoard& board) {
 	cout << "\nPress [Enter] to view search board.\n";
 	cin.get();
-	SearchBoard::instance()->print();
+	board.print();
 	cout << "Done search board test.\n";
 }
 
+// Test compiled search board matches CSV files
+void testBoardData(const SearchBoard& board) {
+	SearchBoard csvBoard(".");
+	for (int layer = 0; layer < SearchBoard::NUM_FILE_LAYERS; layer++) {
+		auto& data = board.getLayer((SearchBoard::Layers) layer);
+		auto& csvData = csvBoard.getLayer((SearchBoard::Layers) layer);
+		for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+			auto zone = GridCoordinate::fromIndex(i);
+			assert(data.isBitOn(zone) == csvData.isBitOn(zone));
+		}
+	}
+	cout << "Done board data tests.\n";
+}
+
+// Test near-zone lookups against a search of each area
+void testNearZoneTypes(const SearchBoard& board) {
+	auto layer = SearchBoard::ConvoyRoutes;
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		auto zone = GridCoordinate::fromIndex(i);
+		for (int dist = 0; dist <= 4; dist++) {
+			bool found = false;
+			for (auto near: zone.getArea(dist)) {
+				found |= board.isConvoyRoute(near);
+			}
+			assert(board.isNearZoneType(zone, dist, layer) == found);
+		}
+	}
+	cout << "Done near-zone tests.\n";
+}
+
+// Test reachable zones against the sea distance table
+//   Also that zones listed by count match those with bits on
+void testReach(const SearchBoard& board) {
+	auto& graph = board.getSeaGraph();
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i += 7) {
+		if (!graph.isAccessible(i)) {
+			continue;
+		}
+		auto zone = GridCoordinate::fromIndex(i);
+		for (int moves = 0; moves <= 5; moves++) {
+			auto reach = board.getReach(zone, moves);
+			for (int j = 0; j < GridCoordinate::NUM_ZONES; j++) {
+				bool inReach = graph.isAccessible(j) 
+					&& graph.getDistance(i, j) <= moves;
+				assert(reach.isBitOn(GridCoordinate::fromIndex(j)) 
+					== inReach);
+			}
+			auto zones = reach.getAllOn();
+			assert(reach.countOn() == (int) zones.size());
+			for (int n = 0; n < (int) zones.size(); n++) {
+				assert(reach.getNthOn(n) == zones[n]);
+			}
+		}
+	}
+	cout << "Done reach tests.\n";
+}
+
+// Test layers derived at load time
+void testDerivedLayers(const SearchBoard& board) {
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		auto zone = GridCoordinate::fromIndex(i);
+		assert(board.isGermanAccessible(zone) ==
+			(board.isSeaZone(zone) && !board.isIrishSea(zone)
+				&& !board.isBritishPort(zone)));
+		if (board.isBritishPatrolLine(zone)) {
+			assert(board.isInsidePatrolLine(zone));
+		}
+		char column = board.getGeneralSearchColumn(zone);
+		assert('A' <= column && column <= 'C');
+	}
+	assert(board.getGeneralSearchColumn("K10") == 'A');
+	cout << "Done derived layer tests.\n";
+}
+
 // Test object sizes
 void testObjectSizes() {
 	assert(sizeof(GridCoordinate) == 2);
@@ -36,6 +133,12 @@ void testCoordinateConstructors() {
 	assert(GridCoordinate('B', 3).toString() == "B3");	
 	assert(GridCoordinate("P18").toString() == "P18");
 	assert(GridCoordinate(string("Z20")).toString() == "Z20");
+	assert(GridCoordinate("A1").index() == 0);
+	assert(GridCoordinate("Z29").index() == GridCoordinate::NUM_ZONES - 1);
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		assert(GridCoordinate::fromIndex(i).index() == i);
+	}
+	assert(!GridCoordinate::OFFBOARD.isOnBoard());
 	cout << "Done coordinate constructor tests.\n";
 }
 
@@ -50,6 +153,10 @@ void testCoordinateDistances() {
 	assert(anchor.distanceFrom("P19") == 9);
 	assert(anchor.distanceFrom("R14") == 7);
 	assert(anchor.distanceFrom("K10") == 0);
+
+	// Off-board zones use formula, same as on board
+	assert(GridCoordinate("A1").distanceFrom(GridCoordinate('A', 0)) == 1);
+	assert(GridCoordinate("Z29").distanceFrom("A1") == 28);
 	cout << "Done coordinate distance tests.\n";
 }
 
@@ -60,34 +167,543 @@ void testCoordinateArea(const GridCoordinate& coord) {
 }
 
 // Test ship construction
-void testShipConstruction() {
-	Ship ship("Bismarck", Ship::Type::BB, 29, 10, 13, "F20");
+void testShipConstruction(GameContext& context) {
+	Ship ship(context, "Bismarck", Ship::Type::BB, 29, 10, 13, "F20");
 	cout << "Ship test: " << ship << endl;
 }
 
-// Test A* pathfinding navigation
-void testNavigatorPath(const GridCoordinate& src, 
-	const GridCoordinate& dest) 
+// Test ship turn log
+//   Recent turns kept in a ring buffer; older ones forgotten
+void testShipLog(GameContext& context) {
+	Ship ship(context, "Bismarck", Ship::Type::BB, 29, 10, 13, "F20");
+	assert(!ship.wasLocated(0));
+	for (int turn = 0; turn < 10; turn++) {
+		ship.doAvailability();
+		if (turn % 3 == 0) {
+			ship.setLocated();
+		}
+		assert(ship.wasLocated(0) == (turn % 3 == 0));
+		assert(ship.wasLocated(1) == (turn > 0 && turn % 3 == 1));
+		assert(ship.wasLocated(2) == (turn > 1 && turn % 3 == 2));
+		assert(!ship.wasLocated(10));
+		assert(ship.getSpeedThisTurn() == 0);
+	}
+	assert(ship.getTimesDetected() == 4);
+	cout << "Done ship log tests.\n";
+}
+
+// Test task force aggregates
+//   Cached values must follow membership & damage changes
+void testTaskForceAggregates(GameContext& context) {
+	Ship bismarck(context, "Bismarck", Ship::Type::BB, 29, 10, 13, "F20");
+	Ship prinz(context, "Prinz Eugen", Ship::Type::CA, 32, 4, 10, "F20");
+	TaskForce taffy(1);
+	taffy.attach(&bismarck);
+	taffy.attach(&prinz);
+	assert(taffy.getEvasion() == 29);
+	assert(taffy.getAttackEvasion() == 32);
+	assert(taffy.getMaxSpeedClass() == 3);
+	bismarck.loseEvasion(10);
+	assert(bismarck.getMaxSpeedClass() == 2);
+	assert(taffy.getEvasion() == 19);
+	assert(taffy.getMaxSpeedClass() == 2);
+	prinz.loseMidships(2);
+	assert(taffy.getAttackEvasion() == 26);
+	taffy.detach(&prinz);
+	assert(taffy.getAttackEvasion() == 19);
+	taffy.dissolve();
+	cout << "Done task force aggregate tests.\n";
+}
+
+// Test sea route navigation
+//   Route must be shortest, by accessible adjacent zones
+void testNavigatorPath(GameContext& context,
+	const GridCoordinate& src, const GridCoordinate& dest) 
 {
 	cout << "Navigator path from " << src << " to " << dest << ": ";
-	Ship ship("Prinz Eugen", Ship::Type::CA, 32, 4, 10, src);
-	vector<GridCoordinate> path = Navigator::findSeaRoute(ship, dest);
+	auto& board = context.getBoard();
+	auto& random = context.getRandom(GameContext::GERMAN_AI);
+	Navigator::Route path;
+	Navigator::findSeaRoute(board, src, dest, random, path);
+	reverse(path.begin(), path.end());
+	printVec(vector<GridCoordinate>(path.begin(), path.end()));
+	auto& graph = board.getSeaGraph();
+	assert((int) path.size() == graph.getDistance(src.index(), dest.index()));
+	GridCoordinate last = src;
+	for (auto& zone: path) {
+		assert(last.distanceFrom(zone) == 1);
+		assert(board.isGermanAccessible(zone));
+		last = zone;
+	}
+	assert(last == dest);
+
+	// Search avoiding no zones gives same length
+	SearchBoardLayer noZones;
+	Navigator::Route searchPath;
+	Navigator::findSeaRoute(board, src, dest, random, searchPath, &noZones);
+	assert(searchPath.size() == path.size());
+
+	// Search avoiding a route zone goes around it
+	if (path.size() > 2) {
+		auto blocked = path[path.size() / 2];
+		SearchBoardLayer avoid("Blocked", [&](const GridCoordinate& zone) 
+			{ return zone == blocked; });
+		Navigator::findSeaRoute(board, src, dest, random, searchPath, &avoid);
+		assert(!searchPath.empty() && find(searchPath.begin(), 
+			searchPath.end(), blocked) == searchPath.end());
+	}
+}
+
+// Test hazard-weighted routes
+//   Route must be valid, and cost the least possible
+//   (found by relaxing all moves until no change)
+void testSafeRoute(GameContext& context,
+	const GridCoordinate& src, const GridCoordinate& dest, int riskScale) 
+{
+	cout << "Safe route (risk " << riskScale << ") from " 
+		<< src << " to " << dest << ": ";
+	auto& board = context.getBoard();
+	auto& random = context.getRandom(GameContext::GERMAN_AI);
+	auto routeCost = [&](const Navigator::Route& route) {
+		int cost = 0;
+		for (auto& zone: route) {
+			cost += Navigator::getMoveCost(board, zone.index(), riskScale);
+		}
+		return cost;
+	};
+	Navigator::Route path, shortPath;
+	Navigator::findSafeSeaRoute(board, src, dest, riskScale, random, path);
+	Navigator::findSeaRoute(board, src, dest, random, shortPath);
 	reverse(path.begin(), path.end());
-	printVec(path);
+	printVec(vector<GridCoordinate>(path.begin(), path.end()));
+	GridCoordinate last = src;
+	for (auto& zone: path) {
+		assert(last.distanceFrom(zone) == 1);
+		assert(board.isGermanAccessible(zone));
+		last = zone;
+	}
+	assert(last == dest);
+	assert(path.size() >= shortPath.size());
+	assert(routeCost(path) <= routeCost(shortPath));
+	auto& graph = board.getSeaGraph();
+	vector<int> leastCost(GridCoordinate::NUM_ZONES, INT_MAX);
+	leastCost[dest.index()] = 0;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+			for (int j = 0; j < graph.getNumNeighbors(i); j++) {
+				int next = graph.getNeighbor(i, j);
+				if (leastCost[next] == INT_MAX) {
+					continue;
+				}
+				int cost = leastCost[next] 
+					+ Navigator::getMoveCost(board, next, riskScale);
+				if (cost < leastCost[i]) {
+					leastCost[i] = cost;
+					changed = true;
+				}
+			}
+		}
+	}
+	assert(routeCost(path) == leastCost[src.index()]);
+}
+
+// Test timed routes
+//   With even costs, route is shortest in the fewest turns
+//   (moving 2, 1, 2, ... as a fast ship must);
+//   if ending the first two turns away from start is costly,
+//   it waits there, then goes; if arriving early is costly,
+//   it spends the slack waiting, not wandering.
+void testTimedRoute(GameContext& context,
+	const GridCoordinate& src, const GridCoordinate& dest) 
+{
+	cout << "Timed route from " << src << " to " << dest << ": ";
+	auto& board = context.getBoard();
+	auto& random = context.getRandom(GameContext::GERMAN_AI);
+	int dist = board.getSeaGraph().getDistance(src.index(), dest.index());
+	auto maxMoves = [](int, bool movedFast) { 
+		return movedFast ? 1 : 2; 
+	};
+	auto checkRoute = [&](Navigator::Route route, 
+		Navigator::TurnMoves turnMoves) 
+	{
+		reverse(route.begin(), route.end());
+		reverse(turnMoves.begin(), turnMoves.end());
+		assert((int) route.size() == dist);
+		GridCoordinate last = src;
+		for (auto& zone: route) {
+			assert(last.distanceFrom(zone) == 1);
+			assert(board.isGermanAccessible(zone));
+			last = zone;
+		}
+		bool movedFast = false;
+		int totalMoves = 0;
+		for (int moves: turnMoves) {
+			assert(moves <= maxMoves(0, movedFast));
+			movedFast = moves > 1;
+			totalMoves += moves;
+		}
+		assert(totalMoves == dist);
+	};
+	Navigator::Route route;
+	Navigator::TurnMoves turnMoves;
+	bool found = Navigator::findTimedSeaRoute(board, src, dest, false, 
+		maxMoves, [](int, int) { return 1; }, 
+		random, route, turnMoves);
+	assert(found);
+	printVec(vector<int>(turnMoves.rbegin(), turnMoves.rend()));
+	checkRoute(route, turnMoves);
+	int fewestTurns = dist / 3 * 2 + (dist % 3 ? 1 : 0);
+	assert((int) turnMoves.size() == fewestTurns);
+	found = Navigator::findTimedSeaRoute(board, src, dest, false, maxMoves, 
+		[&](int zone, int turn) { 
+			return turn < 2 && zone != src.index() ? 100 : 1; 
+		}, 
+		random, route, turnMoves);
+	assert(found);
+	checkRoute(route, turnMoves);
+	assert((int) turnMoves.size() == fewestTurns + 2);
+	assert(turnMoves.rbegin()[0] == 0 && turnMoves.rbegin()[1] == 0);
+	int arriveTurn = fewestTurns + 3;
+	found = Navigator::findTimedSeaRoute(board, src, dest, false, maxMoves, 
+		[&](int zone, int turn) { 
+			return turn < arriveTurn && zone == dest.index() ? 100 : 1; 
+		}, 
+		random, route, turnMoves);
+	assert(found);
+	checkRoute(route, turnMoves);
+	assert((int) turnMoves.size() == arriveTurn + 1);
+}
+
+// Test sea distance fields against the distance table
+//   Field must give the nearest destination zone, by sea
+void testDistanceFields(const SearchBoard& board) {
+	auto& graph = board.getSeaGraph();
+	auto ports = board.getLayer(SearchBoard::GermanPorts).getAllOn();
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		if (graph.isAccessible(i)) {
+			auto zone = GridCoordinate::fromIndex(i);
+			int minDist = SeaGraph::UNREACHABLE;
+			for (auto& port: ports) {
+				minDist = min(minDist, graph.getDistance(i, port.index()));
+			}
+			auto nearest = board.getNearest(zone, SearchBoard::ToGermanPorts);
+			assert(board.getSeaDistance(zone, SearchBoard::ToGermanPorts) 
+				== minDist);
+			assert(graph.getDistance(i, nearest.index()) == minDist);
+			assert(board.isGermanPort(nearest));
+			assert(board.getSeaDistance(zone, SearchBoard::ToRowZ) 
+				>= 'Z' - zone.getRow());
+		}
+	}
+	GridCoordinate exitZone("Z20");
+	assert(board.getSeaDistance(exitZone, SearchBoard::ToRowZ) == 0);
+	assert(board.getSeaDistance("X20", SearchBoard::ToRowZ) == 2);
+	cout << "Done distance field tests.\n";
+}
+
+// Test exact arrival turns by speed class & fuel
+//   Speed class 3 alternates 2 & 1 zones per turn;
+//   emergency speed moves only on convoy turns;
+//   slow battleship on last fuel waits for convoy turns.
+void testArrivalTable(const SearchBoard& board) {
+	const auto FAST = Ship::FAST_FUEL_USE, SLOW = Ship::SLOW_BB_FUEL_USE;
+	assert(Ship::calcTurnsToGo(FAST, 3, false, 10, true, 0) == 0);
+	assert(Ship::calcTurnsToGo(FAST, 3, false, 10, true, 3) == 2);
+	assert(Ship::calcTurnsToGo(FAST, 3, false, 10, true, 4) == 3);
+	assert(Ship::calcTurnsToGo(FAST, 3, true, 10, true, 3) == 2);
+	assert(Ship::calcTurnsToGo(FAST, 3, false, 1, true, 2) == 2);
+	assert(Ship::calcTurnsToGo(FAST, 3, false, 0, true, 2) == 3);
+	assert(Ship::calcTurnsToGo(FAST, 3, false, 0, false, 2) == 4);
+	assert(Ship::calcTurnsToGo(SLOW, 2, false, 2, true, 4) == 4);
+	assert(Ship::calcTurnsToGo(SLOW, 2, false, 1, true, 4) == 5);
+	assert(Ship::calcTurnsToGo(FAST, 0, false, 10, true, 1) 
+		== Ship::NEVER_ARRIVES);
+
+	// Table covers every distance by sea on the board
+	auto& graph = board.getSeaGraph();
+	for (int i = 0; i < GridCoordinate::NUM_ZONES; i++) {
+		for (int j = 0; j < GridCoordinate::NUM_ZONES; j++) {
+			int distance = graph.getDistance(i, j);
+			assert(distance == SeaGraph::UNREACHABLE
+				|| distance <= Ship::MAX_ETA_DISTANCE);
+		}
+	}
+	cout << "Done arrival table tests.\n";
+}
+
+// Test heap allocations over full games
+//   Ships keep orders, routes & recent log inline, and per-turn
+//   lists are reused, so a game allocates a few times in all,
+//   however long it runs: tripling its length adds none.
+void testGameAllocations(const SearchBoard& board) {
+	const int NUM_GAMES = 20;
+	const int SHORT_FINISH = 20, LONG_FINISH = 60;
+	auto countAllocs = [&](int finishTurn) {
+		string finishArg = "-f=" + to_string(finishTurn);
+		char* argv[] = {(char*) "test", (char*) "-a", (char*) "-s=1",
+			(char*) finishArg.c_str()};
+		CmdArgs args;
+		args.parseArgs(4, argv);
+		long total = 0;
+		for (int i = 0; i < NUM_GAMES; i++) {
+			GameContext context(board, args, i);
+			long before = numAllocs;
+			context.getDirector().doGameLoop();
+			total += numAllocs - before;
+		}
+		return (double) total / NUM_GAMES;
+	};
+	cgame.turnOff();
+	clog.setstate(ios::failbit);
+	double shortAllocs = countAllocs(SHORT_FINISH);
+	double longAllocs = countAllocs(LONG_FINISH);
+	clog.clear();
+	cgame.turnOn();
+	cout << "Allocations per game: " << shortAllocs << " (to turn " 
+		<< SHORT_FINISH << "), " << longAllocs << " (to turn " 
+		<< LONG_FINISH << ")\n";
+	assert(longAllocs - shortAllocs < 1);
+}
+
+// Test game snapshot & restore
+//   Playing on from a restored state (here, or in another
+//   context for the same game) must repeat the first result
+void testGameSnapshot(const SearchBoard& board) {
+	const int NUM_GAMES = 20, SNAPSHOT_TURN = 10;
+	char* argv[] = {(char*) "test", (char*) "-a", (char*) "-s=1",
+		(char*) "-oas", (char*) "-osg", (char*) "-ott", 
+		(char*) "-ofe", (char*) "-ofd"};
+	CmdArgs args;
+	args.parseArgs(8, argv);
+	auto playOut = [](GameContext& context) {
+		auto& game = context.getDirector();
+		while (!game.isGameOver()) {
+			game.doGameTurn();
+		}
+		return to_string(game.getTurn()) 
+			+ " " + to_string(game.getConvoysSunk())
+			+ " " + to_string(game.getBismarck().getTimesDetected())
+			+ " " + game.getBismarck().getFullDesc();
+	};
+	cgame.turnOff();
+	clog.setstate(ios::failbit);
+	for (int i = 0; i < NUM_GAMES; i++) {
+		GameContext context(board, args, i);
+		auto& game = context.getDirector();
+		while (!game.isGameOver() && game.getTurn() < SNAPSHOT_TURN) {
+			game.doGameTurn();
+		}
+		GameState state;
+		context.snapshot(state);
+		string result = playOut(context);
+		context.restore(state);
+		assert(playOut(context) == result);
+		GameContext fork(board, args, i);
+		fork.restore(state);
+		assert(playOut(fork) == result);
+	}
+	clog.clear();
+	cgame.turnOn();
+	cout << "Game state size: " << sizeof(GameState) << " bytes\n";
+	cout << "Done game snapshot tests.\n";
+}
+
+// Get a ship's log record from last turn (in a saved state)
+auto& lastTurnLog(Ship::State& ship) {
+	int logTurns = sizeof ship.log / sizeof ship.log[0];
+	return ship.log[(ship.turnsLogged - 2) % logTurns];
+}
+
+// Test incremental game hash
+//   Checked against a full recompute every turn; a game starts
+//   from the same state each time (British air patrols are
+//   planned per game), and a restored snapshot has its hash.
+//   Changing any one item that decides later play changes it.
+void testGameHash(const SearchBoard& board) {
+	const int NUM_GAMES = 20, SNAPSHOT_TURN = 10;
+	char* argv[] = {(char*) "test", (char*) "-a", (char*) "-s=2",
+		(char*) "-oas", (char*) "-osg", (char*) "-ott", 
+		(char*) "-ofe", (char*) "-ofd"};
+	CmdArgs args;
+	args.parseArgs(8, argv);
+	cgame.turnOff();
+	clog.setstate(ios::failbit);
+	for (int i = 0; i < NUM_GAMES; i++) {
+		GameContext context(board, args, i);
+		auto& game = context.getDirector();
+		assert(game.getHash() == game.calcHash());
+		GameContext twin(board, args, i);
+		assert(game.getHash() == twin.getDirector().getHash());
+		GameState state;
+		uint64_t snapshotHash = 0;
+		while (!game.isGameOver()) {
+			uint64_t lastHash = game.getHash();
+			game.doGameTurn();
+			assert(game.getHash() == game.calcHash());
+			assert(game.getHash() != lastHash);
+			if (game.getTurn() == SNAPSHOT_TURN) {
+				context.snapshot(state);
+				snapshotHash = game.getHash();
+			}
+		}
+		assert(snapshotHash);
+		context.restore(state);
+		assert(game.getHash() == snapshotHash);
+		assert(game.getHash() == game.calcHash());
+
+		// Change one item at a time in the saved state
+		typedef void (*Change)(GameState&);
+		Change changes[] = {
+			[](GameState& s) { auto& ship = s.german.ships[0];
+				ship.onPatrol = !ship.onPatrol; },
+			[](GameState& s) { auto& ship = s.german.ships[0];
+				ship.returnToBase = !ship.returnToBase; },
+			[](GameState& s) { auto& german = s.german;
+				if (german.numTaskForces) {
+					german.numTaskForces--;
+				}
+				else {
+					german.taskForces[0] = {9, 2, {0, 1}};
+					german.numTaskForces = 1;
+				} },
+			[](GameState& s) { auto& log = lastTurnLog(s.german.ships[0]);
+				log.located = !log.located; },
+			[](GameState& s) { auto& log = lastTurnLog(s.german.ships[0]);
+				log.convoySunk = !log.convoySunk; },
+			[](GameState& s) { auto& log = lastTurnLog(s.german.ships[0]);
+				log.numMoves = log.numMoves > 1 ? 1 : 2; },
+			[](GameState& s) { s.director.convoySunkDays ^= 1; },
+			[](GameState& s) { s.british.initialAirPatrols[0]++; }
+		};
+		for (auto change: changes) {
+			GameState changed = state;
+			change(changed);
+			context.restore(changed);
+			assert(game.calcHash() != snapshotHash);
+		}
+	}
+	clog.clear();
+	cgame.turnOn();
+	cout << "Done game hash tests.\n";
+}
+
+// Test route sampling by path counts
+//   K10 to N11 has three shortest routes, one via L11:
+//   uniform sampling takes that a third of the time 
+//   (not half, as picking uniformly each step would);
+//   weighting L11 by 4 makes it two-thirds.
+void testNavigatorSampling(GameContext& context) {
+	const int NUM_TRIALS = 3000;
+	auto& board = context.getBoard();
+	auto& random = context.getRandom(GameContext::GERMAN_AI);
+	GridCoordinate src("K10"), dest("N11"), via("L11");
+	assert(board.getSeaGraph().getNumRoutes(src.index(), dest.index()) == 3);
+	vector<float> weights(GridCoordinate::NUM_ZONES, 1.0f);
+	weights[via.index()] = 4.0f;
+	Navigator::Route path;
+	int viaTable = 0, viaSearch = 0, viaWeighted = 0;
+	for (int i = 0; i < NUM_TRIALS; i++) {
+		Navigator::findSeaRoute(board, src, dest, random, path);
+		viaTable += path.back() == via;
+		SearchBoardLayer noZones;
+		Navigator::findSeaRoute(board, src, dest, random, path, &noZones);
+		viaSearch += path.back() == via;
+		Navigator::findSeaRoute(board, src, dest, random, path, 
+			nullptr, weights.data());
+		viaWeighted += path.back() == via;
+	}
+	cout << "Navigator routes via " << via << ": " 
+		<< viaTable << ", " << viaSearch << ", " << viaWeighted 
+		<< " of " << NUM_TRIALS << endl;
+	assert(abs(viaTable - NUM_TRIALS / 3) < NUM_TRIALS / 20);
+	assert(abs(viaSearch - NUM_TRIALS / 3) < NUM_TRIALS / 20);
+	assert(abs(viaWeighted - NUM_TRIALS * 2 / 3) < NUM_TRIALS / 20);
+}
+
+// Test counter-based random numbers
+void testRandomStream() {
+
+	// Known answer for Philox4x32-10 (Random123 test vector)
+	RandomStream zeroStream(0, 0);
+	assert(zeroStream.next() == 0x6627e8d5);
+	assert(zeroStream.next() == 0xe169c58d);
+	assert(zeroStream.next() == 0xbc57ac4c);
+	assert(zeroStream.next() == 0x9b00dbd8);
+
+	// Same seed & game replay exactly; other games & streams differ
+	RandomStream streamA(1234, 567), streamB(1234, 567);
+	RandomStream streamC(1234, 568), streamD(1234, 567, 1);
+	bool anyDiffer = false, anyStreamDiffer = false;
+	for (int i = 0; i < 1000; i++) {
+		int roll = streamA.dieRoll(6);
+		assert(roll == streamB.dieRoll(6));
+		assert(isInInterval(1, roll, 6));
+		anyDiffer |= (roll != streamC.dieRoll(6));
+		anyStreamDiffer |= (roll != streamD.dieRoll(6));
+	}
+	assert(anyDiffer && anyStreamDiffer);
+	cout << "Done random stream tests.\n";
+}
+
+// Test running statistics
+void testRunningStat() {
+
+	// Mean & variance of 1..10, whole or merged in parts
+	RunningStat whole, low, high;
+	for (int i = 1; i <= 10; i++) {
+		whole.add(i);
+		(i <= 4 ? low : high).add(i);
+	}
+	low.merge(high);
+	assert(whole.getCount() == 10 && low.getCount() == 10);
+	assert(fabs(whole.getMean() - 5.5) < 1e-12);
+	assert(fabs(whole.getVariance() - 55.0 / 6) < 1e-12);
+	assert(fabs(low.getMean() - whole.getMean()) < 1e-12);
+	assert(fabs(low.getVariance() - whole.getVariance()) < 1e-12);
+
+	// Wilson interval for 0 of 20 stays inside [0, 1]
+	RunningStat none;
+	for (int i = 0; i < 20; i++) {
+		none.add(0);
+	}
+	assert(none.getWilsonLow() >= -1e-12);
+	assert(none.getWilsonHigh() > 0.1 && none.getWilsonHigh() < 0.2);
+	cout << "Done running stat tests.\n";
 }
 
 // Main test driver
 int main(int argc, char** argv) {
-	srand(time(0));
+	SearchBoard board;
+	CmdArgs args;
+	GameContext context(board, args);
 
 	// Test basic stuff
 	testObjectSizes();
 	testCoordinateConstructors();
 	testCoordinateDistances();
 	testCoordinateArea("J16");
-	testShipConstruction();
-	testNavigatorPath("F20", "B7");
-	testNavigatorPath("F20", "P23");
-	testSearchBoard();
+	testRandomStream();
+	testRunningStat();
+	testShipConstruction(context);
+	testShipLog(context);
+	testTaskForceAggregates(context);
+	testNavigatorPath(context, "F20", "B7");
+	testNavigatorPath(context, "F20", "P23");
+	testNavigatorSampling(context);
+	testSafeRoute(context, "F20", "P23", 2);
+	testSafeRoute(context, "C19", "T10", Navigator::MAX_RISK_SCALE);
+	testTimedRoute(context, "K10", "T15");
+	testDistanceFields(board);
+	testArrivalTable(board);
+	testGameAllocations(board);
+	testGameSnapshot(board);
+	testGameHash(board);
+	testBoardData(board);
+	testNearZoneTypes(board);
+	testReach(board);
+	testDerivedLayers(board);
+	testSearchBoard(board);
 	return 0;
 }
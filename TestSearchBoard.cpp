@@ -11,6 +11,7 @@
 
 // Min test driver
 int main(int argc, char** argv) {
-	SearchBoard::instance()->print();
+	SearchBoard board;
+	board.print();
 	return 0;
 }
\ No newline at end of file
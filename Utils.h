@@ -12,15 +12,6 @@
 #include <iostream>
 #include <algorithm>
 
-// Seed the random number generator.
-void seedRandom();
-
-// Dice-rolling prototypes.
-double randDecimal();
-int rand(int bound);
-int dieRoll(int sides);
-int diceRoll(int num, int sides);
-
 // Get a Y/N response from stdin.
 bool getUserYes();
 
@@ -44,13 +35,6 @@ bool hasElem(const std::vector<T>& vec, const T& value) {
 	return find(vec.begin(), vec.end(), value) != vec.end();
 }
 
-// Get random element from a vector
-template<class T>
-T randomElem(const std::vector<T>& vec) {
-	assert(vec.size() > 0);
-	return vec[rand() % vec.size()];
-}
-
 // Print a vector
 template<class T>
 void printVec(std::vector<T> vec) {